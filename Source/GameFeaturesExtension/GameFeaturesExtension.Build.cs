@@ -25,5 +25,11 @@ public class GameFeaturesExtension : ModuleRules
 			"CommonGame",
 			"ModularGameplay",
 		});
+
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("TargetPlatform");
+			PrivateDependencyModuleNames.Add("AssetRegistry");
+		}
 	}
 }
@@ -0,0 +1,111 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureAction_AddWorldSystem.h"
+#include "GameFeatureAction_WorldActionBase.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/Package.h"
+
+/**
+ * Inspection commands for live sessions. They only read the bookkeeping the world actions keep anyway,
+ * so they are available in every build configuration, including shipping builds with a console.
+ */
+namespace UE::GameFeaturesExtension::ConsoleCommands
+{
+	static void DumpActiveActions(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const FString Filter = Args.IsValidIndex(0) ? Args[0] : FString();
+
+		TMap<FName, TArray<const UGameFeatureAction_WorldActionBase*>> ActionsByFeature;
+		UGameFeatureAction_WorldActionBase::ForEachActiveAction([&ActionsByFeature, &Filter](const UGameFeatureAction_WorldActionBase& Action)
+			{
+				const FName FeatureName = Action.GetPackage()->GetFName();
+				if (Filter.IsEmpty() || FeatureName.ToString().Contains(Filter) || Action.GetClass()->GetName().Contains(Filter))
+				{
+					ActionsByFeature.FindOrAdd(FeatureName).Add(&Action);
+				}
+			});
+
+		ActionsByFeature.KeySort(FNameLexicalLess());
+
+		const double Now = FPlatformTime::Seconds();
+		SIZE_T TotalBytes = 0;
+		int32 NumActions = 0;
+
+		for (const TPair<FName, TArray<const UGameFeatureAction_WorldActionBase*>>& Pair : ActionsByFeature)
+		{
+			Ar.Logf(TEXT("%s"), *Pair.Key.ToString());
+
+			for (const UGameFeatureAction_WorldActionBase* Action : Pair.Value)
+			{
+				const SIZE_T Bytes = Action->GetRuntimeAllocatedSize();
+				const double LastActivationTime = Action->GetLastActivationTime();
+
+				Ar.Logf(TEXT("  %s  Bytes=%llu  LastActivation=%.1fs ago"),
+					*Action->GetName(), static_cast<uint64>(Bytes), LastActivationTime > 0.0 ? Now - LastActivationTime : 0.0);
+				Action->DumpActiveContexts(Ar);
+
+				TotalBytes += Bytes;
+				++NumActions;
+			}
+		}
+
+		if (GEngine)
+		{
+			for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+			{
+				const UWorld* ContextWorld = WorldContext.World();
+				const UGameFeatureWorldSystemManager* SystemManager = ContextWorld ? ContextWorld->GetSubsystem<UGameFeatureWorldSystemManager>() : nullptr;
+				if ((SystemManager == nullptr) || SystemManager->GetSystemInstances().IsEmpty())
+				{
+					continue;
+				}
+
+				Ar.Logf(TEXT("World systems of %s"), *ContextWorld->GetName());
+				for (const TPair<TObjectPtr<UGameFeatureWorldSystem>, int32>& System : SystemManager->GetSystemInstances())
+				{
+					Ar.Logf(TEXT("  %s  Requests=%d"), *GetNameSafe(System.Key), System.Value);
+				}
+			}
+		}
+
+		Ar.Logf(TEXT("%d active world actions in %d features, %llu bytes of bookkeeping"), NumActions, ActionsByFeature.Num(), static_cast<uint64>(TotalBytes));
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("GameFeaturesExtension.Dump"),
+		TEXT("Lists the active world actions grouped by feature, with their contexts, bookkeeping size and world system ref counts. Usage: GameFeaturesExtension.Dump [Filter]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpActiveActions));
+
+	static void DumpFeatureStats(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		TArray<FName> FeatureNames;
+		UGameFeatureAction_WorldActionBase::GetFeatureActivityStats().GetKeys(FeatureNames);
+		FeatureNames.Sort(FNameLexicalLess());
+
+		const double Now = FPlatformTime::Seconds();
+		for (const FName FeatureName : FeatureNames)
+		{
+			const FGameFeatureActivityStats& Stats = UGameFeatureAction_WorldActionBase::GetFeatureActivityStats().FindChecked(FeatureName);
+			Ar.Logf(TEXT("%-64s Activations: %5d  Deactivations: %5d  LastActivation: %8.1fs ago  Activate: %9.3f ms  Deactivate: %9.3f ms  ActivationMemory: %8lld KB  DeactivationMemory: %8lld KB"),
+				*FeatureName.ToString(), Stats.NumActivations, Stats.NumDeactivations,
+				Stats.LastActivationTime > 0.0 ? Now - Stats.LastActivationTime : 0.0,
+				Stats.ActivationSeconds * 1000.0, Stats.DeactivationSeconds * 1000.0,
+				Stats.ActivationBytes / 1024, Stats.DeactivationBytes / 1024);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice StatsCommand(
+		TEXT("GameFeaturesExtension.Stats"),
+		TEXT("Prints the activation counters recorded per feature. Memory columns are only filled while GameFeaturesExtension.TrackMemoryDeltas is enabled."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&DumpFeatureStats));
+
+	static FAutoConsoleCommand ResetCountersCommand(
+		TEXT("GameFeaturesExtension.ResetCounters"),
+		TEXT("Clears the activation counters recorded per feature."),
+		FConsoleCommandDelegate::CreateStatic(&UGameFeatureAction_WorldActionBase::ResetFeatureActivityStats));
+}
@@ -0,0 +1,308 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureActionCostEstimator.h"
+
+#if WITH_EDITOR
+
+#include "AssetRegistry/AssetBundleData.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "GameFeatureAction.h"
+#include "GameFeatureActionSet.h"
+#include "GameFeatureData.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DataValidation.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+namespace UE::GameFeaturesExtension::Cost
+{
+	static float MaxActionDiskSizeMB = 0.f;
+	static FAutoConsoleVariableRef CVarMaxActionDiskSizeMB(
+		TEXT("GameFeaturesExtension.Cost.MaxActionDiskSizeMB"),
+		MaxActionDiskSizeMB,
+		TEXT("Size on disk (MB) of the packages a single action pulls in above which it fails validation. 0 disables the budget."),
+		ECVF_Default);
+
+	static int32 MaxActionPackages = 0;
+	static FAutoConsoleVariableRef CVarMaxActionPackages(
+		TEXT("GameFeaturesExtension.Cost.MaxActionPackages"),
+		MaxActionPackages,
+		TEXT("Number of packages a single action pulls in above which it fails validation. 0 disables the budget."),
+		ECVF_Default);
+
+	static float MaxFeatureDiskSizeMB = 0.f;
+	static FAutoConsoleVariableRef CVarMaxFeatureDiskSizeMB(
+		TEXT("GameFeaturesExtension.Cost.MaxFeatureDiskSizeMB"),
+		MaxFeatureDiskSizeMB,
+		TEXT("Size on disk (MB) of the packages all actions of a feature pull in above which it fails validation. 0 disables the budget."),
+		ECVF_Default);
+
+	static float MaxFeatureMemoryMB = 0.f;
+	static FAutoConsoleVariableRef CVarMaxFeatureMemoryMB(
+		TEXT("GameFeaturesExtension.Cost.MaxFeatureMemoryMB"),
+		MaxFeatureMemoryMB,
+		TEXT("Estimated memory (MB) of the packages all actions of a feature pull in above which it fails validation. 0 disables the budget."),
+		ECVF_Default);
+
+	static float MemoryToDiskRatio = 1.f;
+	static FAutoConsoleVariableRef CVarMemoryToDiskRatio(
+		TEXT("GameFeaturesExtension.Cost.MemoryToDiskRatio"),
+		MemoryToDiskRatio,
+		TEXT("Factor applied to the size on disk of the editor packages to estimate their resident memory once loaded. Tune it per project by comparing with GameFeaturesExtension.Stats."),
+		ECVF_Default);
+
+	static bool bOverBudgetIsError = false;
+	static FAutoConsoleVariableRef CVarOverBudgetIsError(
+		TEXT("GameFeaturesExtension.Cost.OverBudgetIsError"),
+		bOverBudgetIsError,
+		TEXT("If true, exceeding a cost budget makes the asset invalid instead of only reporting a warning."),
+		ECVF_Default);
+
+	static constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+	static bool IsScriptPackage(FName PackageName)
+	{
+		TStringBuilder<256> PackageString;
+		PackageName.ToString(PackageString);
+		return FStringView(PackageString).StartsWith(TEXT("/Script/"));
+	}
+
+	/** Adds the assets the action references, either directly or through its asset bundles */
+	static void GatherReferencedAssets(const UGameFeatureAction& Action, TSet<FSoftObjectPath>& OutAssets)
+	{
+		const UPackage* ActionPackage = Action.GetPackage();
+
+		for (TPropertyValueIterator<FProperty> It(Action.GetClass(), &Action); It; ++It)
+		{
+			const FProperty* Property = It.Key();
+			const void* Value = It.Value();
+
+			if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(Property))
+			{
+				const FSoftObjectPath& Path = static_cast<const FSoftObjectPtr*>(Value)->ToSoftObjectPath();
+				if (Path.IsAsset())
+				{
+					OutAssets.Add(Path);
+				}
+			}
+			else if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+			{
+				// Instanced subobjects live in the package of the action, their own references are not followed
+				const UObject* Object = ObjectProperty->GetObjectPropertyValue(Value);
+				if (Object && (Object->GetPackage() != ActionPackage))
+				{
+					OutAssets.Add(FSoftObjectPath(Object));
+				}
+			}
+		}
+
+#if WITH_EDITORONLY_DATA
+		FAssetBundleData BundleData;
+		const_cast<UGameFeatureAction&>(Action).AddAdditionalAssetBundleData(BundleData);
+		for (const FAssetBundleEntry& Bundle : BundleData.Bundles)
+		{
+			for (const FTopLevelAssetPath& AssetPath : Bundle.AssetPaths)
+			{
+				OutAssets.Add(FSoftObjectPath(AssetPath));
+			}
+		}
+#endif
+	}
+
+	/** Resolves the assets referenced by actions to packages and their sizes, caching the size of every package it visits */
+	class FResolver
+	{
+	public:
+		FResolver()
+			: AssetRegistry(IAssetRegistry::GetChecked())
+		{
+		}
+
+		FGameFeatureActionCost Estimate(const UGameFeatureAction& Action)
+		{
+			FGameFeatureActionCost Cost;
+			Cost.ActionName = Action.GetPathName();
+
+			TSet<FSoftObjectPath> Assets;
+			GatherReferencedAssets(Action, Assets);
+
+			TArray<FName> PackagesToVisit;
+			for (const FSoftObjectPath& Asset : Assets)
+			{
+				const FName PackageName = Asset.GetLongPackageFName();
+				if (PackageName.IsNone() || IsScriptPackage(PackageName))
+				{
+					continue;
+				}
+
+				Cost.AssetCountsByClass.FindOrAdd(GetAssetClassName(PackageName))++;
+				PackagesToVisit.Add(PackageName);
+			}
+
+			// Whatever the referenced assets hard reference is loaded along with them
+			while (!PackagesToVisit.IsEmpty())
+			{
+				const FName PackageName = PackagesToVisit.Pop(EAllowShrinking::No);
+
+				bool bAlreadyVisited = false;
+				Cost.Packages.Add(PackageName, &bAlreadyVisited);
+				if (bAlreadyVisited)
+				{
+					continue;
+				}
+
+				Cost.DiskBytes += GetDiskSize(PackageName);
+
+				TArray<FName> Dependencies;
+				AssetRegistry.GetDependencies(PackageName, Dependencies, UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+				for (const FName Dependency : Dependencies)
+				{
+					if (!IsScriptPackage(Dependency) && !Cost.Packages.Contains(Dependency))
+					{
+						PackagesToVisit.Add(Dependency);
+					}
+				}
+			}
+
+			Cost.EstimatedMemoryBytes = static_cast<int64>(Cost.DiskBytes * MemoryToDiskRatio);
+			return Cost;
+		}
+
+		int64 GetDiskSize(FName PackageName)
+		{
+			if (const int64* CachedSize = DiskSizes.Find(PackageName))
+			{
+				return *CachedSize;
+			}
+
+			const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+			const int64 DiskSize = (PackageData.IsSet() && PackageData->DiskSize > 0) ? PackageData->DiskSize : 0;
+			DiskSizes.Add(PackageName, DiskSize);
+			return DiskSize;
+		}
+
+	private:
+		FName GetAssetClassName(FName PackageName) const
+		{
+			TArray<FAssetData> PackageAssets;
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+			return PackageAssets.IsEmpty() ? FName(TEXT("Unknown")) : PackageAssets[0].AssetClassPath.GetAssetName();
+		}
+
+		IAssetRegistry& AssetRegistry;
+		TMap<FName, int64> DiskSizes;
+	};
+}
+
+FGameFeatureActionCost FGameFeatureActionCostEstimator::EstimateAction(const UGameFeatureAction& Action)
+{
+	UE::GameFeaturesExtension::Cost::FResolver Resolver;
+	return Resolver.Estimate(Action);
+}
+
+FGameFeatureCostReport FGameFeatureActionCostEstimator::EstimateActions(TConstArrayView<const UGameFeatureAction*> Actions)
+{
+	UE::GameFeaturesExtension::Cost::FResolver Resolver;
+
+	FGameFeatureCostReport Report;
+	TSet<FName> AllPackages;
+
+	for (const UGameFeatureAction* Action : Actions)
+	{
+		if (Action)
+		{
+			FGameFeatureActionCost& Cost = Report.Actions.Add_GetRef(Resolver.Estimate(*Action));
+			AllPackages.Append(Cost.Packages);
+		}
+	}
+
+	Report.NumPackages = AllPackages.Num();
+	for (const FName PackageName : AllPackages)
+	{
+		Report.DiskBytes += Resolver.GetDiskSize(PackageName);
+	}
+	Report.EstimatedMemoryBytes = static_cast<int64>(Report.DiskBytes * UE::GameFeaturesExtension::Cost::MemoryToDiskRatio);
+
+	return Report;
+}
+
+TArray<const UGameFeatureAction*> FGameFeatureActionCostEstimator::GetFeatureActions(const UObject& FeatureAsset)
+{
+	TArray<const UGameFeatureAction*> Actions;
+
+	if (const UGameFeatureData* FeatureData = Cast<UGameFeatureData>(&FeatureAsset))
+	{
+		Actions.Append(FeatureData->GetActions());
+	}
+	else if (const UGameFeatureActionSet* ActionSet = Cast<UGameFeatureActionSet>(&FeatureAsset))
+	{
+		ActionSet->ForEachAction([&Actions](const UGameFeatureAction& Action)
+			{
+				Actions.Add(&Action);
+			});
+	}
+
+	return Actions;
+}
+
+bool FGameFeatureActionCostEstimator::CheckActionBudgets(const FGameFeatureActionCost& Cost, FDataValidationContext& Context)
+{
+	using namespace UE::GameFeaturesExtension::Cost;
+
+	bool bWithinBudget = true;
+
+	const double DiskSizeMB = Cost.DiskBytes / BytesPerMB;
+	if ((MaxActionDiskSizeMB > 0.f) && (DiskSizeMB > MaxActionDiskSizeMB))
+	{
+		bWithinBudget = false;
+		Context.AddWarning(FText::Format(LOCTEXT("ActionDiskBudgetExceeded", "{0} pulls in {1} MB of packages, above the budget of {2} MB (GameFeaturesExtension.Cost.MaxActionDiskSizeMB)."),
+			FText::FromString(Cost.ActionName), FText::AsNumber(DiskSizeMB), FText::AsNumber(MaxActionDiskSizeMB)));
+	}
+
+	if ((MaxActionPackages > 0) && (Cost.Packages.Num() > MaxActionPackages))
+	{
+		bWithinBudget = false;
+		Context.AddWarning(FText::Format(LOCTEXT("ActionPackageBudgetExceeded", "{0} pulls in {1} packages, above the budget of {2} (GameFeaturesExtension.Cost.MaxActionPackages)."),
+			FText::FromString(Cost.ActionName), FText::AsNumber(Cost.Packages.Num()), FText::AsNumber(MaxActionPackages)));
+	}
+
+	return bWithinBudget;
+}
+
+bool FGameFeatureActionCostEstimator::CheckFeatureBudgets(const FGameFeatureCostReport& Report, FDataValidationContext& Context)
+{
+	using namespace UE::GameFeaturesExtension::Cost;
+
+	bool bWithinBudget = true;
+
+	const double DiskSizeMB = Report.DiskBytes / BytesPerMB;
+	if ((MaxFeatureDiskSizeMB > 0.f) && (DiskSizeMB > MaxFeatureDiskSizeMB))
+	{
+		bWithinBudget = false;
+		Context.AddWarning(FText::Format(LOCTEXT("FeatureDiskBudgetExceeded", "The actions pull in {0} MB of packages, above the budget of {1} MB (GameFeaturesExtension.Cost.MaxFeatureDiskSizeMB)."),
+			FText::AsNumber(DiskSizeMB), FText::AsNumber(MaxFeatureDiskSizeMB)));
+	}
+
+	const double MemoryMB = Report.EstimatedMemoryBytes / BytesPerMB;
+	if ((MaxFeatureMemoryMB > 0.f) && (MemoryMB > MaxFeatureMemoryMB))
+	{
+		bWithinBudget = false;
+		Context.AddWarning(FText::Format(LOCTEXT("FeatureMemoryBudgetExceeded", "The actions are estimated to use {0} MB once loaded, above the budget of {1} MB (GameFeaturesExtension.Cost.MaxFeatureMemoryMB)."),
+			FText::AsNumber(MemoryMB), FText::AsNumber(MaxFeatureMemoryMB)));
+	}
+
+	return bWithinBudget;
+}
+
+EDataValidationResult FGameFeatureActionCostEstimator::GetOverBudgetResult()
+{
+	return UE::GameFeaturesExtension::Cost::bOverBudgetIsError ? EDataValidationResult::Invalid : EDataValidationResult::Valid;
+}
+
+#undef LOCTEXT_NAMESPACE
+
+#endif // WITH_EDITOR
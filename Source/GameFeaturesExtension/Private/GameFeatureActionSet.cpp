@@ -4,21 +4,146 @@
 #include "GameFeatureActionSet.h"
 
 #if WITH_EDITOR
+#include "GameFeatureActionCostEstimator.h"
 #include "Misc/DataValidation.h"
 #include "UObject/ObjectSaveContext.h"
 #endif
 
 #include "GameFeatureAction.h"
+#include "GameFeaturesSubsystem.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UnrealType.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureActionSet)
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
+namespace UE::GameFeaturesExtension::ActionSet
+{
+	/** Returns true if both actions are of the same class and all of their properties match, including instanced subobjects */
+	static bool AreActionsIdentical(const UGameFeatureAction& A, const UGameFeatureAction& B)
+	{
+		if (A.GetClass() != B.GetClass())
+		{
+			return false;
+		}
+
+		for (TFieldIterator<FProperty> It(A.GetClass()); It; ++It)
+		{
+			if (It->HasAnyPropertyFlags(CPF_Transient))
+			{
+				continue;
+			}
+
+			if (!It->Identical_InContainer(&A, &B, 0, PPF_DeepComparison))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/** Appends the actions of Set after the ones of its includes (post-order), skipping actions identical to one already added */
+	static bool Flatten(const UGameFeatureActionSet& Set, TArray<const UGameFeatureActionSet*>& Visiting, TSet<const UGameFeatureActionSet*>& Visited, TArray<TObjectPtr<UGameFeatureAction>>& OutActions)
+	{
+		if (Visiting.Contains(&Set))
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("[GameFeatureActionSet %s]: Included action sets form a cycle, it is skipped."), *GetPathNameSafe(&Set));
+			return false;
+		}
+
+		bool bAlreadyVisited = false;
+		Visited.Add(&Set, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			// Diamond includes, the shared set was already added
+			return true;
+		}
+
+		bool bSuccess = true;
+		Visiting.Push(&Set);
+		for (const UGameFeatureActionSet* Included : Set.IncludedActionSets)
+		{
+			if (Included)
+			{
+				bSuccess &= Flatten(*Included, Visiting, Visited, OutActions);
+			}
+		}
+		Visiting.Pop();
+
+		for (UGameFeatureAction* Action : Set.Actions)
+		{
+			if (Action == nullptr)
+			{
+				continue;
+			}
+
+			const bool bIsDuplicate = OutActions.ContainsByPredicate([Action](const UGameFeatureAction* Existing)
+				{
+					return (Existing == Action) || AreActionsIdentical(*Existing, *Action);
+				});
+
+			if (!bIsDuplicate)
+			{
+				OutActions.Add(Action);
+			}
+		}
+
+		return bSuccess;
+	}
+}
+
 UGameFeatureActionSet::UGameFeatureActionSet()
 {
 	FeatureDependencies = GameFeaturesToEnable.Num();
 }
 
+void UGameFeatureActionSet::PostLoad()
+{
+	Super::PostLoad();
+
+	// Actions that don't apply to the cooked target (e.g. client-only actions on servers) are stripped and load as null
+	if (FPlatformProperties::RequiresCookedData())
+	{
+		Actions.RemoveAll([](const TObjectPtr<UGameFeatureAction>& Action)
+			{
+				return Action == nullptr;
+			});
+
+		AllActions.RemoveAll([](const TObjectPtr<UGameFeatureAction>& Action)
+			{
+				return Action == nullptr;
+			});
+
+		// Actions stays as authored, only AllActions is deduplicated. Duplicates are still loaded with every set including them.
+	}
+	else
+	{
+		RebuildAllActions();
+	}
+}
+
+const TArray<TObjectPtr<UGameFeatureAction>>& UGameFeatureActionSet::GetAllActions() const
+{
+	// Sets created at runtime without includes don't need to be flattened
+	if (AllActions.IsEmpty() && IncludedActionSets.IsEmpty())
+	{
+		return Actions;
+	}
+
+	return AllActions;
+}
+
+bool UGameFeatureActionSet::RebuildAllActions()
+{
+	TArray<const UGameFeatureActionSet*> Visiting;
+	TSet<const UGameFeatureActionSet*> Visited;
+
+	AllActions.Reset();
+	return UE::GameFeaturesExtension::ActionSet::Flatten(*this, Visiting, Visited, AllActions);
+}
+
 #if WITH_EDITOR
 EDataValidationResult UGameFeatureActionSet::IsDataValid(class FDataValidationContext& Context) const
 {
@@ -42,9 +167,64 @@ EDataValidationResult UGameFeatureActionSet::IsDataValid(class FDataValidationCo
 		++EntryIndex;
 	}
 
+	EntryIndex = 0;
+	for (const UGameFeatureActionSet* Included : IncludedActionSets)
+	{
+		if (Included == nullptr)
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("IncludedActionSetIsNull", "Null entry in IncludedActionSets array at index {0}"),
+				FText::AsNumber(EntryIndex)));
+		}
+
+		++EntryIndex;
+	}
+
+	TArray<const UGameFeatureActionSet*> Visiting;
+	TSet<const UGameFeatureActionSet*> Visited;
+	TArray<TObjectPtr<UGameFeatureAction>> FlattenedActions;
+	if (!UE::GameFeaturesExtension::ActionSet::Flatten(*this, Visiting, Visited, FlattenedActions))
+	{
+		Result = EDataValidationResult::Invalid;
+		Context.AddError(LOCTEXT("IncludedActionSetsCycle", "IncludedActionSets form a cycle"));
+	}
+	else
+	{
+		const FGameFeatureCostReport Report = FGameFeatureActionCostEstimator::EstimateActions(FGameFeatureActionCostEstimator::GetFeatureActions(*this));
+		if (!FGameFeatureActionCostEstimator::CheckFeatureBudgets(Report, Context))
+		{
+			Result = CombineDataValidationResults(Result, FGameFeatureActionCostEstimator::GetOverBudgetResult());
+		}
+	}
+
 	return Result;
 }
 
+void UGameFeatureActionSet::PreSave(FObjectPreSaveContext ObjectSaveContext)
+{
+	// Flatten now so cooked builds never walk the include hierarchy or compare actions.
+	// Before the super call, which updates the asset bundles from the flattened actions.
+	RebuildAllActions();
+
+	Super::PreSave(ObjectSaveContext);
+}
+
+void UGameFeatureActionSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	RebuildAllActions();
+
+	// Loaded sets including this one flattened its previous actions
+	for (TObjectIterator<UGameFeatureActionSet> It; It; ++It)
+	{
+		if ((*It != this) && !It->IncludedActionSets.IsEmpty())
+		{
+			It->RebuildAllActions();
+		}
+	}
+}
+
 void UGameFeatureActionSet::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
 {
 	Super::PostSaveRoot(ObjectSaveContext);
@@ -57,7 +237,7 @@ void UGameFeatureActionSet::UpdateAssetBundleData()
 {
 	Super::UpdateAssetBundleData();
 
-	for (UGameFeatureAction* Action : Actions)
+	for (UGameFeatureAction* Action : GetAllActions())
 	{
 		if (Action)
 		{
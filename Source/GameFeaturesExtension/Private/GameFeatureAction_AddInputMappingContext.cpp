@@ -8,9 +8,13 @@
 #endif
 
 #include "EnhancedInputSubsystems.h"
+#include "GameFeaturesExtensionStats.h"
+#include "GameFeatureActivationTrace.h"
+#include "GameFeatureStreamingManager.h"
 #include "InputMappingContext.h"
 #include "Components/GameFrameworkComponentManager.h"
 #include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "UserSettings/EnhancedInputUserSettings.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddInputMappingContext)
@@ -21,46 +25,46 @@ void UGameFeatureAction_AddInputMappingContext::OnGameFeatureRegistering()
 {
 	Super::OnGameFeatureRegistering();
 
-	RegisterInputMappingContexts();
-}
-
-void UGameFeatureAction_AddInputMappingContext::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
-{
-	FPerContextData& ActiveData = ContextData.FindOrAdd(Context);
-
-	if (!ensure(ActiveData.ExtensionRequestHandles.IsEmpty()) ||
-		!ensure(ActiveData.ControllersAddedTo.IsEmpty()))
+#if !UE_SERVER
+	if (IsRelevantForThisProcess())
 	{
-		Reset(ActiveData);
+		RegisterInputMappingContexts();
 	}
-	
-	Super::OnGameFeatureActivating(Context);
+#endif
 }
 
-void UGameFeatureAction_AddInputMappingContext::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+void UGameFeatureAction_AddInputMappingContext::OnGameFeatureUnregistering()
 {
-	Super::OnGameFeatureDeactivating(Context);
+	Super::OnGameFeatureUnregistering();
 
-	FPerContextData* ActiveData = ContextData.Find(Context);
-	if (ensure(ActiveData))
+#if !UE_SERVER
+	if (IsRelevantForThisProcess())
 	{
-		Reset(*ActiveData);
+		UnregisterInputMappingContexts();
 	}
+#endif
 }
 
-void UGameFeatureAction_AddInputMappingContext::OnGameFeatureUnregistering()
+EGameFeatureActionNetExecution UGameFeatureAction_AddInputMappingContext::GetNetExecution() const
 {
-	Super::OnGameFeatureUnregistering();
+	// Input only exists for local players
+	return EGameFeatureActionNetExecution::ClientOnly;
+}
 
-	UnregisterInputMappingContexts();
+void UGameFeatureAction_AddInputMappingContext::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for (const FInputMappingContextAndPriority& Entry : InputMappings)
+	{
+		OutAssets.Add(Entry.InputMapping.ToSoftObjectPath());
+	}
 }
 
 void UGameFeatureAction_AddInputMappingContext::OnAddToWorld(
 	const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
 {
+#if !UE_SERVER
 	const UWorld* World = WorldContext.World();
 	const UGameInstance* GameInstance = WorldContext.OwningGameInstance;
-	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
 
 	if (GameInstance == nullptr)
 	{
@@ -72,6 +76,39 @@ void UGameFeatureAction_AddInputMappingContext::OnAddToWorld(
 		return;
 	}
 
+	FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+	TArray<FSoftObjectPath> MappingsToLoad;
+	GatherMappingsToLoad(/*bSettingsOnly*/ false, MappingsToLoad);
+
+	if (MappingsToLoad.IsEmpty())
+	{
+		HandleMappingsLoaded(const_cast<UGameInstance*>(GameInstance), ChangeContext);
+		return;
+	}
+
+	// Controllers receive the mappings once they streamed in
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(MappingsToLoad), EGameFeatureStreamingPriority::GameplayCritical,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleMappingsLoaded, MakeWeakObjectPtr(const_cast<UGameInstance*>(GameInstance)), ChangeContext), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		ActiveData.LoadHandles.Add(LoadHandle);
+	}
+#endif
+}
+
+void UGameFeatureAction_AddInputMappingContext::HandleMappingsLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext)
+{
+	UGameInstance* GameInstance = WeakGameInstance.Get();
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+
+	if ((GameInstance == nullptr) || (ActiveData == nullptr))
+	{
+		return;
+	}
+
 	if (UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance))
 	{
 		UGameFrameworkComponentManager::FExtensionHandlerDelegate AddInputMappingsDelegate =
@@ -80,10 +117,31 @@ void UGameFeatureAction_AddInputMappingContext::OnAddToWorld(
 		TSharedPtr<FComponentRequestHandle> RequestHandle =
 			ComponentManager->AddExtensionHandler(APlayerController::StaticClass(), AddInputMappingsDelegate);
 
-		ActiveData.ExtensionRequestHandles.Add(RequestHandle);
+		ActiveData->ExtensionRequestHandles.Add(RequestHandle);
+	}
+}
+
+void UGameFeatureAction_AddInputMappingContext::GatherMappingsToLoad(bool bSettingsOnly, TArray<FSoftObjectPath>& OutMappings) const
+{
+	for (const FInputMappingContextAndPriority& Entry : InputMappings)
+	{
+		if (bSettingsOnly && !Entry.bRegisterWithSettings)
+		{
+			continue;
+		}
+
+		if (!Entry.InputMapping.IsNull() && (Entry.InputMapping.Get() == nullptr))
+		{
+			OutMappings.AddUnique(Entry.InputMapping.ToSoftObjectPath());
+		}
 	}
 }
 
+void UGameFeatureAction_AddInputMappingContext::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	Reset(static_cast<FPerContextData&>(ContextState));
+}
+
 #if WITH_EDITOR
 EDataValidationResult UGameFeatureAction_AddInputMappingContext::IsDataValid(FDataValidationContext& Context) const
 {
@@ -148,9 +206,40 @@ void UGameFeatureAction_AddInputMappingContext::RegisterInputMappingContextsForL
 		return;
 	}
 
-	UE_LOG(LogGameFeatures, Display, TEXT("%hs Registering Input Mapping Contexts for LocalPlayer [%s]"), __func__, *LocalPlayer->GetName());
+	UE_LOG(LogGameFeatures, Verbose, TEXT("%hs Registering Input Mapping Contexts for LocalPlayer [%s]"), __func__, *LocalPlayer->GetName());
+
+	TArray<FSoftObjectPath> MappingsToLoad;
+	GatherMappingsToLoad(/*bSettingsOnly*/ true, MappingsToLoad);
+
+	if (MappingsToLoad.IsEmpty())
+	{
+		RegisterLoadedInputMappingContextsForLocalPlayer(LocalPlayer);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(MappingsToLoad), EGameFeatureStreamingPriority::GameplayCritical,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::RegisterLoadedInputMappingContextsForLocalPlayer, MakeWeakObjectPtr(LocalPlayer)), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		SettingsLoadHandles.Add(LoadHandle);
+	}
+}
+
+void UGameFeatureAction_AddInputMappingContext::RegisterLoadedInputMappingContextsForLocalPlayer(TWeakObjectPtr<ULocalPlayer> WeakLocalPlayer)
+{
+	SettingsLoadHandles.RemoveAllSwap([](const TSharedPtr<FStreamableHandle>& Handle)
+		{
+			return !Handle.IsValid() || Handle->HasLoadCompleted() || Handle->WasCanceled();
+		});
+
+	ULocalPlayer* LocalPlayer = WeakLocalPlayer.Get();
+	if (LocalPlayer == nullptr)
+	{
+		return;
+	}
 
-	UAssetManager& AssetManager = UAssetManager::Get();
 	if (UEnhancedInputLocalPlayerSubsystem* InputSub = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(LocalPlayer))
 	{
 		if (UEnhancedInputUserSettings* Settings = InputSub->GetUserSettings())
@@ -163,16 +252,13 @@ void UGameFeatureAction_AddInputMappingContext::RegisterInputMappingContextsForL
 					continue;
 				}
 
-				const UInputMappingContext* MappingContext = Entry.InputMapping.Get();
-				if (!MappingContext)
+				if (const UInputMappingContext* MappingContext = Entry.InputMapping.Get())
 				{
-					MappingContext = Entry.InputMapping.LoadSynchronous();
-					ensureAlwaysMsgf(MappingContext, TEXT("Failed to load asset [%s]"), *Entry.InputMapping.ToString());
+					Settings->RegisterInputMappingContext(MappingContext);
 				}
-
-				if (MappingContext)
+				else
 				{
-					Settings->RegisterInputMappingContext(MappingContext);
+					ensureAlwaysMsgf(Entry.InputMapping.IsNull(), TEXT("Failed to load asset [%s]"), *Entry.InputMapping.ToString());
 				}
 			}
 		}
@@ -189,6 +275,15 @@ void UGameFeatureAction_AddInputMappingContext::RegisterInputMappingContextsForL
 
 void UGameFeatureAction_AddInputMappingContext::UnregisterInputMappingContexts()
 {
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : SettingsLoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	SettingsLoadHandles.Empty();
+
 	FWorldDelegates::OnStartGameInstance.Remove(RegisterInputContextMappingsForGameInstanceHandle);
 	RegisterInputContextMappingsForGameInstanceHandle.Reset();
 
@@ -245,6 +340,15 @@ void UGameFeatureAction_AddInputMappingContext::UnregisterInputMappingContextsFo
 
 void UGameFeatureAction_AddInputMappingContext::Reset(FPerContextData& ActiveData)
 {
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : ActiveData.LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	ActiveData.LoadHandles.Empty();
+
 	ActiveData.ExtensionRequestHandles.Empty();
 	
 	while (!ActiveData.ControllersAddedTo.IsEmpty())
@@ -264,26 +368,34 @@ void UGameFeatureAction_AddInputMappingContext::Reset(FPerContextData& ActiveDat
 void UGameFeatureAction_AddInputMappingContext::HandleControllerExtension(
 	AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext)
 {
+	RECORD_GAMEFEATURE_EXTENSION_EVENT(Actor, EventName);
+
 	APlayerController* PC = CastChecked<APlayerController>(Actor);
-	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return;
+	}
 
-	UE_LOG(LogGameFeatures, Display, TEXT("%hs Handling Controller Extension for Player [%s] (%s)"), __func__, *PC->GetName(), *EventName.ToString());
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Extension"), TEXT("%s %s %s %s"), *GetPackage()->GetName(), *GetClass()->GetName(), *EventName.ToString(), *PC->GetName());
+	UE_LOG(LogGameFeatures, Verbose, TEXT("%hs Handling Controller Extension for Player [%s] (%s)"), __func__, *PC->GetName(), *EventName.ToString());
 
 	if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) ||
 		(EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 	{
-		RemoveInputMapping(PC, ActiveData);
+		RemoveInputMapping(PC, *ActiveData);
 	}
 	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) ||
 		(EventName == "BindInputsNow"))
 	{
-		AddInputMappingForPlayer(PC->GetLocalPlayer(), ActiveData);
+		AddInputMappingForPlayer(PC->GetLocalPlayer(), *ActiveData);
+		ActiveData->ControllersAddedTo.AddUnique(PC);
 	}
 }
 
 void UGameFeatureAction_AddInputMappingContext::AddInputMappingForPlayer(UPlayer* Player, FPerContextData& ActiveData)
 {
-	UE_LOG(LogGameFeatures, Display, TEXT("%hs Adding Input Mapping Contexts for Player [%s]"), __func__, *Player->GetName());
+	UE_LOG(LogGameFeatures, Verbose, TEXT("%hs Adding Input Mapping Contexts for Player [%s]"), __func__, *Player->GetName());
 	
 	if (ULocalPlayer* LP = Cast<ULocalPlayer>(Player))
 	{
@@ -297,7 +409,7 @@ void UGameFeatureAction_AddInputMappingContext::AddInputMappingForPlayer(UPlayer
 				}
 			}
 
-			UE_LOG(LogGameFeatures, Display, TEXT("Added Input Mapping Contexts (%d) for Player [%s]"), InputMappings.Num(), *Player->GetName());
+			UE_LOG(LogGameFeatures, Verbose, TEXT("Added Input Mapping Contexts (%d) for Player [%s]"), InputMappings.Num(), *Player->GetName());
 		}
 		else
 		{
@@ -333,6 +445,8 @@ void UGameFeatureAction_AddInputMappingContext::RemoveInputMapping(APlayerContro
 	{
 		UE_LOG(LogGameFeatures, Error, TEXT("Failed to find LocalPlayer for PlayerController [%s]. Input mappings wont be removed."), *PlayerController->GetName());
 	}
+
+	ActiveData.ControllersAddedTo.Remove(PlayerController);
 }
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
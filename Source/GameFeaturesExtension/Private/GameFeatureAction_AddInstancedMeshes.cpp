@@ -0,0 +1,359 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureAction_AddInstancedMeshes.h"
+
+#include "AssetRegistry/AssetBundleData.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFeatureStreamingManager.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "GameFramework/Actor.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Text.h"
+#include "Templates/TypeHash.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#include "UObject/Package.h"
+#include "UnrealEngine.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddInstancedMeshes)
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+namespace UE::GameFeaturesExtension::InstancedMeshes
+{
+	/** Everything an instanced component is configured with, entries only share a component if all of it matches */
+	struct FComponentKey
+	{
+		UStaticMesh* Mesh = nullptr;
+		bool bUseHierarchicalInstancing = true;
+		ECollisionEnabled::Type CollisionEnabled = ECollisionEnabled::NoCollision;
+		int32 InstanceStartCullDistance = 0;
+		int32 InstanceEndCullDistance = 0;
+
+		FComponentKey(UStaticMesh* InMesh, const FGameFeatureInstancedMeshEntry& Entry)
+			: Mesh(InMesh)
+			, bUseHierarchicalInstancing(Entry.bUseHierarchicalInstancing)
+			, CollisionEnabled(Entry.CollisionEnabled)
+			, InstanceStartCullDistance(Entry.InstanceStartCullDistance)
+			, InstanceEndCullDistance(Entry.InstanceEndCullDistance)
+		{
+		}
+
+		bool operator==(const FComponentKey& Other) const
+		{
+			return (Mesh == Other.Mesh)
+				&& (bUseHierarchicalInstancing == Other.bUseHierarchicalInstancing)
+				&& (CollisionEnabled == Other.CollisionEnabled)
+				&& (InstanceStartCullDistance == Other.InstanceStartCullDistance)
+				&& (InstanceEndCullDistance == Other.InstanceEndCullDistance);
+		}
+
+		friend uint32 GetTypeHash(const FComponentKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.bUseHierarchicalInstancing));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Key.CollisionEnabled)));
+			Hash = HashCombine(Hash, GetTypeHash(Key.InstanceStartCullDistance));
+			return HashCombine(Hash, GetTypeHash(Key.InstanceEndCullDistance));
+		}
+	};
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_AddInstancedMeshes
+
+#if WITH_EDITORONLY_DATA
+void UGameFeatureAction_AddInstancedMeshes::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
+{
+	if (UAssetManager::IsInitialized())
+	{
+		for (const FGameFeatureInstancedMeshWorldEntry& Entry : InstancedMeshesList)
+		{
+			for (const FGameFeatureInstancedMeshEntry& MeshEntry : Entry.Meshes)
+			{
+				if (MeshEntry.Mesh.IsNull())
+				{
+					continue;
+				}
+
+				AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateClient, MeshEntry.Mesh.ToSoftObjectPath().GetAssetPath());
+
+				// Servers only care about the meshes for their collision
+				if (MeshEntry.CollisionEnabled != ECollisionEnabled::NoCollision)
+				{
+					AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateServer, MeshEntry.Mesh.ToSoftObjectPath().GetAssetPath());
+				}
+			}
+		}
+	}
+}
+#endif
+
+#if WITH_EDITOR
+EDataValidationResult UGameFeatureAction_AddInstancedMeshes::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	int32 EntryIndex = 0;
+	for (const FGameFeatureInstancedMeshWorldEntry& Entry : InstancedMeshesList)
+	{
+		int32 MeshIndex = 0;
+		for (const FGameFeatureInstancedMeshEntry& MeshEntry : Entry.Meshes)
+		{
+			if (MeshEntry.Mesh.IsNull())
+			{
+				Result = EDataValidationResult::Invalid;
+				Context.AddError(FText::Format(LOCTEXT("NullInstancedMesh", "Null Mesh for mesh #{0} at index {1} in InstancedMeshesList."), FText::AsNumber(MeshIndex), FText::AsNumber(EntryIndex)));
+			}
+			++MeshIndex;
+		}
+		++EntryIndex;
+	}
+
+	return Result;
+}
+#endif
+
+void UGameFeatureAction_AddInstancedMeshes::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for (const FGameFeatureInstancedMeshWorldEntry& Entry : InstancedMeshesList)
+	{
+		for (const FGameFeatureInstancedMeshEntry& MeshEntry : Entry.Meshes)
+		{
+			// Purely visual meshes are skipped on dedicated servers
+			if (IsRunningDedicatedServer() && (MeshEntry.CollisionEnabled == ECollisionEnabled::NoCollision))
+			{
+				continue;
+			}
+
+			OutAssets.Add(MeshEntry.Mesh.ToSoftObjectPath());
+		}
+	}
+}
+
+void UGameFeatureAction_AddInstancedMeshes::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	UWorld* World = WorldContext.World();
+
+	if ((World == nullptr) || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+	TArray<const FGameFeatureInstancedMeshEntry*> MeshEntries;
+	GatherMeshEntriesForWorld(*World, MeshEntries);
+
+	TArray<FSoftObjectPath> MeshesToLoad;
+	for (const FGameFeatureInstancedMeshEntry* MeshEntry : MeshEntries)
+	{
+		if (MeshEntry->Mesh.IsPending())
+		{
+			MeshesToLoad.AddUnique(MeshEntry->Mesh.ToSoftObjectPath());
+		}
+	}
+
+	if (MeshesToLoad.IsEmpty())
+	{
+		AddMeshesToWorld(*World, ActiveData);
+		return;
+	}
+
+	// The holder is spawned once the meshes streamed in
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(MeshesToLoad), EGameFeatureStreamingPriority::Visual,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleMeshesLoaded, MakeWeakObjectPtr(World), ChangeContext), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		ActiveData.LoadHandles.Add(LoadHandle);
+	}
+}
+
+void UGameFeatureAction_AddInstancedMeshes::GatherMeshEntriesForWorld(UWorld& World, TArray<const FGameFeatureInstancedMeshEntry*>& OutEntries) const
+{
+#if WITH_EDITOR
+	// Allow resolving of TargetWorld in proper context
+	FTemporaryPlayInEditorIDOverride IDHelper(World.GetPackage()->GetPIEInstanceID());
+#endif
+
+	const bool bIsDedicatedServer = World.GetNetMode() == NM_DedicatedServer;
+
+	for (const FGameFeatureInstancedMeshWorldEntry& Entry : InstancedMeshesList)
+	{
+		if (!Entry.TargetWorld.IsNull())
+		{
+			UWorld* TargetWorld = Entry.TargetWorld.Get();
+			if (TargetWorld != &World)
+			{
+				// These meshes are intended for a specific world (not this one)
+				continue;
+			}
+		}
+
+		for (const FGameFeatureInstancedMeshEntry& MeshEntry : Entry.Meshes)
+		{
+			if (MeshEntry.InstanceTransforms.IsEmpty() || MeshEntry.Mesh.IsNull())
+			{
+				continue;
+			}
+
+			if (bIsDedicatedServer && (MeshEntry.CollisionEnabled == ECollisionEnabled::NoCollision))
+			{
+				// Purely visual, nothing to do on a dedicated server
+				continue;
+			}
+
+			OutEntries.Add(&MeshEntry);
+		}
+	}
+}
+
+void UGameFeatureAction_AddInstancedMeshes::HandleMeshesLoaded(TWeakObjectPtr<UWorld> WeakWorld, FGameFeatureStateChangeContext ChangeContext)
+{
+	UWorld* World = WeakWorld.Get();
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+
+	if ((World == nullptr) || (ActiveData == nullptr))
+	{
+		return;
+	}
+
+	AddMeshesToWorld(*World, *ActiveData);
+}
+
+void UGameFeatureAction_AddInstancedMeshes::AddMeshesToWorld(UWorld& World, FPerContextData& ActiveData)
+{
+	using UE::GameFeaturesExtension::InstancedMeshes::FComponentKey;
+
+	TArray<const FGameFeatureInstancedMeshEntry*> MeshEntries;
+	GatherMeshEntriesForWorld(World, MeshEntries);
+
+	// Gather all transforms per mesh and settings first, so entries only differing in their transforms end up in a single component
+	TMap<FComponentKey, TArray<const FGameFeatureInstancedMeshEntry*>> EntriesByComponent;
+	for (const FGameFeatureInstancedMeshEntry* MeshEntry : MeshEntries)
+	{
+		UStaticMesh* Mesh = MeshEntry->Mesh.Get();
+		if (ensureAlwaysMsgf(Mesh, TEXT("Failed to load asset [%s]"), *MeshEntry->Mesh.ToString()))
+		{
+			EntriesByComponent.FindOrAdd(FComponentKey(Mesh, *MeshEntry)).Add(MeshEntry);
+		}
+	}
+
+	if (EntriesByComponent.IsEmpty())
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* HolderActor = World.SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (!ensure(HolderActor))
+	{
+		return;
+	}
+
+	USceneComponent* RootComponent = NewObject<USceneComponent>(HolderActor, TEXT("Root"));
+	HolderActor->SetRootComponent(RootComponent);
+	HolderActor->AddInstanceComponent(RootComponent);
+	RootComponent->RegisterComponent();
+
+	for (const TPair<FComponentKey, TArray<const FGameFeatureInstancedMeshEntry*>>& Pair : EntriesByComponent)
+	{
+		const FComponentKey& Settings = Pair.Key;
+
+		UInstancedStaticMeshComponent* MeshComponent = Settings.bUseHierarchicalInstancing
+			? NewObject<UHierarchicalInstancedStaticMeshComponent>(HolderActor)
+			: NewObject<UInstancedStaticMeshComponent>(HolderActor);
+
+		MeshComponent->SetStaticMesh(Settings.Mesh);
+		MeshComponent->SetCollisionEnabled(Settings.CollisionEnabled);
+		MeshComponent->SetCullDistances(Settings.InstanceStartCullDistance, Settings.InstanceEndCullDistance);
+		MeshComponent->SetupAttachment(RootComponent);
+
+		// Upload all transforms in one batch before registering, so the render state and cluster tree are only built once
+		TArray<FTransform> InstanceTransforms;
+		for (const FGameFeatureInstancedMeshEntry* MeshEntry : Pair.Value)
+		{
+			InstanceTransforms.Append(MeshEntry->InstanceTransforms);
+		}
+		MeshComponent->AddInstances(InstanceTransforms, /*bShouldReturnIndices*/ false, /*bWorldSpace*/ true);
+
+		HolderActor->AddInstanceComponent(MeshComponent);
+		MeshComponent->RegisterComponent();
+	}
+
+	ActiveData.HolderActors.Add(HolderActor);
+}
+
+void UGameFeatureAction_AddInstancedMeshes::CancelLoads(FPerContextData& ActiveData)
+{
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : ActiveData.LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	ActiveData.LoadHandles.Empty();
+}
+
+void UGameFeatureAction_AddInstancedMeshes::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+	CancelLoads(ActiveData);
+
+	for (TWeakObjectPtr<AActor>& ActorPtr : ActiveData.HolderActors)
+	{
+		if (ActorPtr.IsValid())
+		{
+			ActorPtr->Destroy();
+		}
+	}
+
+	ActiveData.HolderActors.Empty();
+}
+
+bool UGameFeatureAction_AddInstancedMeshes::SupportsIncrementalTeardown() const
+{
+	return true;
+}
+
+bool UGameFeatureAction_AddInstancedMeshes::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+	CancelLoads(ActiveData);
+
+	if (!ActiveData.HolderActors.IsEmpty())
+	{
+		if (AActor* HolderActor = ActiveData.HolderActors.Pop(EAllowShrinking::No).Get())
+		{
+			HolderActor->Destroy();
+		}
+	}
+
+	return ActiveData.HolderActors.IsEmpty();
+}
+
+void UGameFeatureAction_AddInstancedMeshes::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// Holders are destroyed along with their world, only forget about them
+	ActiveData.HolderActors.RemoveAllSwap([World](const TWeakObjectPtr<AActor>& ActorPtr)
+		{
+			return !ActorPtr.IsValid() || ActorPtr->GetWorld() == World;
+		});
+}
+
+#undef LOCTEXT_NAMESPACE
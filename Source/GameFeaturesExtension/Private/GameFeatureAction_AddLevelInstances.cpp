@@ -11,6 +11,7 @@
 #include "Engine/LevelStreaming.h"
 #include "Engine/LevelStreamingDynamic.h"
 #include "Engine/World.h"
+#include "GameFeatureStreamingManager.h"
 #include "HAL/PlatformCrt.h"
 #include "Internationalization/Internationalization.h"
 #include "Internationalization/Text.h"
@@ -34,28 +35,6 @@ struct FGameFeatureDeactivatingContext;
 //////////////////////////////////////////////////////////////////////
 // UGameFeatureAction_AddLevelInstances
 
-void UGameFeatureAction_AddLevelInstances::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
-{
-	FWorldDelegates::OnWorldCleanup.AddUObject(this, &UGameFeatureAction_AddLevelInstances::OnWorldCleanup);
-
-	if (!ensureAlways(AddedLevels.Num() == 0))
-	{
-		DestroyAddedLevels();
-	}
-
-	bIsActivated = true;
-	Super::OnGameFeatureActivating(Context);
-}
-
-void UGameFeatureAction_AddLevelInstances::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
-{
-	DestroyAddedLevels();
-	bIsActivated = false;
-
-	FWorldDelegates::OnWorldCleanup.RemoveAll(this);
-	Super::OnGameFeatureDeactivating(Context);
-}
-
 #if WITH_EDITOR
 EDataValidationResult UGameFeatureAction_AddLevelInstances::IsDataValid(FDataValidationContext& Context) const
 {
@@ -82,51 +61,163 @@ void UGameFeatureAction_AddLevelInstances::OnAddToWorld(const FWorldContext& Wor
 	UWorld* World = WorldContext.World();
 	UGameInstance* GameInstance = WorldContext.OwningGameInstance;
 
-	if (ensureAlways(bIsActivated) && (GameInstance != nullptr) && (World != nullptr) && World->IsGameWorld())
+	if ((GameInstance != nullptr) && (World != nullptr) && World->IsGameWorld())
 	{
 #if WITH_EDITOR
 		// Allow resolving of TargetWorld in proper context
 		FTemporaryPlayInEditorIDOverride IDHelper(World->GetPackage()->GetPIEInstanceID());
 #endif
-		AddedLevels.Reserve(AddedLevels.Num() + LevelInstanceList.Num());
+		FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+		TArray<const FGameFeatureLevelInstanceEntry*> Entries;
+		GatherEntriesForWorld(*World, Entries);
+
+		ActiveData.AddedLevels.Reserve(ActiveData.AddedLevels.Num() + Entries.Num());
+		for (const FGameFeatureLevelInstanceEntry* Entry : Entries)
+		{
+			LoadDynamicLevelForEntry(*Entry, HashEntry(*Entry), World, ActiveData);
+		}
+	}
+}
+
+void UGameFeatureAction_AddLevelInstances::FPerContextData::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FAddedLevel& Added : AddedLevels)
+	{
+		Collector.AddReferencedObject(Added.Level);
+	}
+}
+
+void UGameFeatureAction_AddLevelInstances::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (const FAddedLevel& Added : ActiveData.AddedLevels)
+	{
+		CleanUpAddedLevel(Added.Level);
+	}
+	ActiveData.AddedLevels.Empty();
+}
+
+bool UGameFeatureAction_AddLevelInstances::SupportsIncrementalTeardown() const
+{
+	return true;
+}
+
+bool UGameFeatureAction_AddLevelInstances::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
 
-		for (const FGameFeatureLevelInstanceEntry& Entry : LevelInstanceList)
+	if (!ActiveData.AddedLevels.IsEmpty())
+	{
+		CleanUpAddedLevel(ActiveData.AddedLevels.Pop(EAllowShrinking::No).Level);
+	}
+
+	return ActiveData.AddedLevels.IsEmpty();
+}
+
+void UGameFeatureAction_AddLevelInstances::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (int32 Index = ActiveData.AddedLevels.Num() - 1; Index >= 0; --Index)
+	{
+		ULevelStreamingDynamic* Level = ActiveData.AddedLevels[Index].Level;
+		if (!Level || Level->GetWorld() == World)
 		{
-			if (!Entry.Level.IsNull())
+			CleanUpAddedLevel(Level);
+			ActiveData.AddedLevels.RemoveAtSwap(Index);
+		}
+	}
+}
+
+void UGameFeatureAction_AddLevelInstances::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		Super::ReconcileContext(ChangeContext);
+		return;
+	}
+
+	ForEachRelevantWorldContext(ChangeContext, [this, ActiveData](const FWorldContext& WorldContext)
+		{
+			UWorld* World = WorldContext.World();
+			if ((WorldContext.OwningGameInstance == nullptr) || (World == nullptr) || !World->IsGameWorld())
+			{
+				return;
+			}
+
+#if WITH_EDITOR
+			// Allow resolving of TargetWorld in proper context
+			FTemporaryPlayInEditorIDOverride IDHelper(World->GetPackage()->GetPIEInstanceID());
+#endif
+
+			TArray<const FGameFeatureLevelInstanceEntry*> Entries;
+			GatherEntriesForWorld(*World, Entries);
+
+			TArray<uint32> DesiredHashes;
+			DesiredHashes.Reserve(Entries.Num());
+			for (const FGameFeatureLevelInstanceEntry* Entry : Entries)
 			{
-				if (!Entry.TargetWorld.IsNull())
+				DesiredHashes.Add(HashEntry(*Entry));
+			}
+
+			TArray<int32> AppliedIndices;
+			TArray<uint32> AppliedHashes;
+			for (int32 Index = 0; Index < ActiveData->AddedLevels.Num(); ++Index)
+			{
+				const ULevelStreamingDynamic* Level = ActiveData->AddedLevels[Index].Level;
+				if (Level && Level->GetWorld() == World)
 				{
-					UWorld* TargetWorld = Entry.TargetWorld.Get();
-					if (TargetWorld != World)
-					{
-						// This level is intended for a specific world (not this one)
-						continue;
-					}
+					AppliedIndices.Add(Index);
+					AppliedHashes.Add(ActiveData->AddedLevels[Index].EntryHash);
 				}
+			}
 
-				LoadDynamicLevelForEntry(Entry, World);
+			TArray<int32> EntriesToLoad;
+			TArray<int32> LevelsToUnload;
+			DiffEntryHashes(AppliedHashes, DesiredHashes, EntriesToLoad, LevelsToUnload);
+
+			// Unchanged levels stay loaded, only removed or edited entries are streamed out
+			for (const int32 AppliedIndex : LevelsToUnload)
+			{
+				const int32 Index = AppliedIndices[AppliedIndex];
+				CleanUpAddedLevel(ActiveData->AddedLevels[Index].Level);
+				ActiveData->AddedLevels.RemoveAtSwap(Index);
 			}
-		}
-	}
 
-	GEngine->BlockTillLevelStreamingCompleted(World);
+			for (const int32 EntryIndex : EntriesToLoad)
+			{
+				LoadDynamicLevelForEntry(*Entries[EntryIndex], DesiredHashes[EntryIndex], World, *ActiveData);
+			}
+		});
 }
 
-void UGameFeatureAction_AddLevelInstances::OnWorldCleanup(UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+void UGameFeatureAction_AddLevelInstances::GatherEntriesForWorld(UWorld& World, TArray<const FGameFeatureLevelInstanceEntry*>& OutEntries) const
 {
-	int32 FoundIndex = AddedLevels.IndexOfByPredicate([World](ULevelStreamingDynamic* InStreamingLevel)
+	for (const FGameFeatureLevelInstanceEntry& Entry : LevelInstanceList)
+	{
+		if (Entry.Level.IsNull())
 		{
-			return InStreamingLevel && InStreamingLevel->GetWorld() == World;
-		});
+			continue;
+		}
 
-	if (FoundIndex != INDEX_NONE)
-	{
-		CleanUpAddedLevel(AddedLevels[FoundIndex]);
-		AddedLevels.RemoveAtSwap(FoundIndex);
+		if (!Entry.TargetWorld.IsNull())
+		{
+			UWorld* TargetWorld = Entry.TargetWorld.Get();
+			if (TargetWorld != &World)
+			{
+				// This level is intended for a specific world (not this one)
+				continue;
+			}
+		}
+
+		OutEntries.Add(&Entry);
 	}
 }
 
-ULevelStreamingDynamic* UGameFeatureAction_AddLevelInstances::LoadDynamicLevelForEntry(const FGameFeatureLevelInstanceEntry& Entry, UWorld* TargetWorld)
+ULevelStreamingDynamic* UGameFeatureAction_AddLevelInstances::LoadDynamicLevelForEntry(const FGameFeatureLevelInstanceEntry& Entry, uint32 EntryHash, UWorld* TargetWorld, FPerContextData& ActiveData)
 {
 	bool bSuccess = false;
 	ULevelStreamingDynamic* StreamingLevelRef = ULevelStreamingDynamic::LoadLevelInstanceBySoftObjectPtr(TargetWorld, Entry.Level, Entry.Location, Entry.Rotation, bSuccess);
@@ -137,7 +228,10 @@ ULevelStreamingDynamic* UGameFeatureAction_AddLevelInstances::LoadDynamicLevelFo
 	}
 	else if (StreamingLevelRef)
 	{
-		AddedLevels.Add(StreamingLevelRef);
+		ActiveData.AddedLevels.Add({ StreamingLevelRef, EntryHash });
+
+		// Streamed in and made visible by the world over the next frames, tracked so less urgent feature loads wait for it
+		FGameFeatureStreamingManager::Get().TrackLevelStreaming(StreamingLevelRef, EGameFeatureStreamingPriority::Visual);
 	}
 
 	return StreamingLevelRef;
@@ -145,26 +239,18 @@ ULevelStreamingDynamic* UGameFeatureAction_AddLevelInstances::LoadDynamicLevelFo
 
 void UGameFeatureAction_AddLevelInstances::OnLevelLoaded()
 {
-	if (ensureAlways(bIsActivated))
-	{
-		// We don't have a way of knowing which instance this was triggered for, so we have to look through them all...
-		for (ULevelStreamingDynamic* Level : AddedLevels)
+	// We don't have a way of knowing which instance this was triggered for, so we have to look through them all...
+	ForEachContextState<FPerContextData>([](FPerContextData& ActiveData)
 		{
-			if (Level && Level->GetLevelStreamingState() == ELevelStreamingState::LoadedNotVisible)
+			for (const FAddedLevel& Added : ActiveData.AddedLevels)
 			{
-				Level->SetShouldBeVisible(true);
+				ULevelStreamingDynamic* Level = Added.Level;
+				if (Level && Level->GetLevelStreamingState() == ELevelStreamingState::LoadedNotVisible)
+				{
+					Level->SetShouldBeVisible(true);
+				}
 			}
-		}
-	}
-}
-
-void UGameFeatureAction_AddLevelInstances::DestroyAddedLevels()
-{
-	for (ULevelStreamingDynamic* Level : AddedLevels)
-	{
-		CleanUpAddedLevel(Level);
-	}
-	AddedLevels.Empty();
+		});
 }
 
 void UGameFeatureAction_AddLevelInstances::CleanUpAddedLevel(ULevelStreamingDynamic* Level)
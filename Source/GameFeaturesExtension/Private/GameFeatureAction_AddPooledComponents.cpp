@@ -0,0 +1,521 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureAction_AddPooledComponents.h"
+
+#include "AssetRegistry/AssetBundleData.h"
+#include "Components/GameFrameworkComponentManager.h"
+#include "Components/SceneComponent.h"
+#include "Engine/AssetManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFeaturesExtensionStats.h"
+#include "GameFeatureActivationTrace.h"
+#include "GameFeatureStreamingManager.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddPooledComponents)
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+namespace UE::GameFeaturesExtension::PooledComponents
+{
+	static int32 MaxRegistrationsPerFrame = 32;
+	static FAutoConsoleVariableRef CVarMaxRegistrationsPerFrame(
+		TEXT("GameFeaturesExtension.PooledComponents.MaxRegistrationsPerFrame"),
+		MaxRegistrationsPerFrame,
+		TEXT("Maximum number of components registered per frame, shared by every Add Pooled Components action. 0 or less registers components as soon as their receiver is ready."));
+
+	static int32 MaxPooledPerClass = 64;
+	static FAutoConsoleVariableRef CVarMaxPooledPerClass(
+		TEXT("GameFeaturesExtension.PooledComponents.MaxPooledPerClass"),
+		MaxPooledPerClass,
+		TEXT("Maximum number of removed components kept per component class for reuse, anything beyond is destroyed."));
+
+	/** The registration budget is global, every action draws from the same one */
+	static uint64 BudgetFrame = 0;
+	static int32 BudgetUsed = 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_AddPooledComponents
+
+void UGameFeatureAction_AddPooledComponents::OnGameFeatureUnloading()
+{
+	Super::OnGameFeatureUnloading();
+
+	// Pooled components are unregistered and unowned, release them all with the next collection
+	for (TPair<TObjectPtr<UClass>, FGameFeatureComponentPool>& Pair : ComponentPools)
+	{
+		for (UActorComponent* Component : Pair.Value.Components)
+		{
+			if (Component)
+			{
+				Component->MarkAsGarbage();
+			}
+		}
+	}
+	ComponentPools.Empty();
+}
+
+#if WITH_EDITORONLY_DATA
+void UGameFeatureAction_AddPooledComponents::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
+{
+	if (UAssetManager::IsInitialized())
+	{
+		for (const FGameFeaturePooledComponentEntry& Entry : ComponentList)
+		{
+			if (Entry.ComponentClass.IsNull())
+			{
+				continue;
+			}
+
+			if (Entry.bClientComponent)
+			{
+				AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateClient, Entry.ComponentClass.ToSoftObjectPath().GetAssetPath());
+			}
+
+			if (Entry.bServerComponent)
+			{
+				AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateServer, Entry.ComponentClass.ToSoftObjectPath().GetAssetPath());
+			}
+		}
+	}
+}
+#endif
+
+#if WITH_EDITOR
+EDataValidationResult UGameFeatureAction_AddPooledComponents::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	int32 EntryIndex = 0;
+	for (const FGameFeaturePooledComponentEntry& Entry : ComponentList)
+	{
+		if (Entry.ActorClass.IsNull())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("PooledComponentEntryHasNullActor", "Null ActorClass at index {0} in ComponentList"), FText::AsNumber(EntryIndex)));
+		}
+
+		if (Entry.ComponentClass.IsNull())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("PooledComponentEntryHasNullComponent", "Null ComponentClass at index {0} in ComponentList"), FText::AsNumber(EntryIndex)));
+		}
+
+		if (!Entry.bClientComponent && !Entry.bServerComponent)
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("PooledComponentEntryNeverAdded", "Entry at index {0} in ComponentList is neither a client nor a server component"), FText::AsNumber(EntryIndex)));
+		}
+
+		const UClass* ComponentClass = Entry.ComponentClass.Get();
+		if (ComponentClass && !ComponentClass->ImplementsInterface(UGameFeaturePoolableComponent::StaticClass()))
+		{
+			Context.AddWarning(FText::Format(LOCTEXT("PooledComponentEntryNotPoolable", "ComponentClass {0} at index {1} in ComponentList doesn't implement GameFeaturePoolableComponent, its components are destroyed instead of pooled"),
+				FText::FromString(ComponentClass->GetName()), FText::AsNumber(EntryIndex)));
+		}
+
+		++EntryIndex;
+	}
+
+	return Result;
+}
+#endif
+
+void UGameFeatureAction_AddPooledComponents::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	const bool bIsServer = !IsRunningClientOnly();
+	const bool bIsClient = !IsRunningDedicatedServer();
+
+	for (const FGameFeaturePooledComponentEntry& Entry : ComponentList)
+	{
+		if ((bIsClient && Entry.bClientComponent) || (bIsServer && Entry.bServerComponent))
+		{
+			OutAssets.Add(Entry.ComponentClass.ToSoftObjectPath());
+		}
+	}
+}
+
+void UGameFeatureAction_AddPooledComponents::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	UWorld* World = WorldContext.World();
+	UGameInstance* GameInstance = WorldContext.OwningGameInstance;
+
+	if ((GameInstance == nullptr) || (World == nullptr) || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+	TArray<FSoftObjectPath> ClassesToLoad;
+	for (const FGameFeaturePooledComponentEntry& Entry : ComponentList)
+	{
+		if (!Entry.ComponentClass.IsNull() && (Entry.ComponentClass.Get() == nullptr))
+		{
+			ClassesToLoad.AddUnique(Entry.ComponentClass.ToSoftObjectPath());
+		}
+	}
+
+	if (ClassesToLoad.IsEmpty())
+	{
+		HandleComponentClassesLoaded(GameInstance, ChangeContext);
+		return;
+	}
+
+	// Only hook into the receivers once every component class is in memory, nothing ever blocks on a load
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction LoadRequest"), TEXT("%s %s (%d assets)"), *GetPackage()->GetName(), *GetClass()->GetName(), ClassesToLoad.Num());
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(ClassesToLoad), EGameFeatureStreamingPriority::GameplayCritical,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleComponentClassesLoaded, MakeWeakObjectPtr(GameInstance), ChangeContext), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		ActiveData.LoadHandles.Add(LoadHandle);
+	}
+}
+
+void UGameFeatureAction_AddPooledComponents::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : ActiveData.LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	ActiveData.LoadHandles.Empty();
+
+	ActiveData.PendingRegistrations.Empty();
+
+	// Releasing the handlers sends an extension removed event to every receiver, which returns their components to the pool
+	ActiveData.ComponentRequests.Empty();
+
+	for (const TPair<FObjectKey, TArray<FAddedComponent>>& Pair : ActiveData.ActorComponents)
+	{
+		for (const FAddedComponent& Added : Pair.Value)
+		{
+			ReleaseComponent(Added.Component.Get());
+		}
+	}
+	ActiveData.ActorComponents.Empty();
+}
+
+void UGameFeatureAction_AddPooledComponents::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	ActiveData.PendingRegistrations.RemoveAllSwap([World](const FPendingRegistration& Pending)
+		{
+			return !Pending.Actor.IsValid() || Pending.Actor->GetWorld() == World;
+		});
+
+	// Components of that world are destroyed along with it and can't be pooled, only forget about them
+	for (auto It = ActiveData.ActorComponents.CreateIterator(); It; ++It)
+	{
+		It->Value.RemoveAllSwap([World](const FAddedComponent& Added)
+			{
+				return !Added.Component.IsValid() || Added.Component->GetWorld() == World;
+			});
+
+		if (It->Value.IsEmpty())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UGameFeatureAction_AddPooledComponents::DescribeRuntime(FStringBuilderBase& Out) const
+{
+	int32 NumPooled = 0;
+	for (const TPair<TObjectPtr<UClass>, FGameFeatureComponentPool>& Pair : ComponentPools)
+	{
+		NumPooled += Pair.Value.Components.Num();
+	}
+	Out.Appendf(TEXT("Pools=%d Pooled=%d RegistrationTicking=%s"), ComponentPools.Num(), NumPooled, RegistrationTickerHandle.IsValid() ? TEXT("true") : TEXT("false"));
+}
+
+void UGameFeatureAction_AddPooledComponents::HandleComponentClassesLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext)
+{
+	UGameInstance* GameInstance = WeakGameInstance.Get();
+	UWorld* World = GameInstance ? GameInstance->GetWorld() : nullptr;
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+
+	if ((World == nullptr) || (ActiveData == nullptr))
+	{
+		return;
+	}
+
+	UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance);
+	if (ComponentManager == nullptr)
+	{
+		return;
+	}
+
+	const ENetMode NetMode = World->GetNetMode();
+	const bool bIsServer = NetMode != NM_Client;
+	const bool bIsClient = NetMode != NM_DedicatedServer;
+
+	for (int32 EntryIndex = 0; EntryIndex < ComponentList.Num(); ++EntryIndex)
+	{
+		const FGameFeaturePooledComponentEntry& Entry = ComponentList[EntryIndex];
+
+		if (!((Entry.bServerComponent && bIsServer) || (Entry.bClientComponent && bIsClient)))
+		{
+			continue;
+		}
+
+		if (Entry.ActorClass.IsNull() || (Entry.ComponentClass.Get() == nullptr))
+		{
+			continue;
+		}
+
+		TSharedPtr<FComponentRequestHandle> ExtensionRequestHandle = ComponentManager->AddExtensionHandler
+		(
+			Entry.ActorClass,
+			UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, EntryIndex, ChangeContext)
+		);
+
+		ActiveData->ComponentRequests.Add(ExtensionRequestHandle);
+	}
+}
+
+void UGameFeatureAction_AddPooledComponents::HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext)
+{
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Extension"), TEXT("%s %s %s %s"), *GetPackage()->GetName(), *GetClass()->GetName(), *EventName.ToString(), *GetNameSafe(Actor));
+	RECORD_GAMEFEATURE_EXTENSION_EVENT(Actor, EventName);
+
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return;
+	}
+
+	if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) ||
+		(EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
+	{
+		RemoveComponents(Actor, EntryIndex, *ActiveData);
+	}
+	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) ||
+		(EventName == UGameFrameworkComponentManager::NAME_GameActorReady))
+	{
+		if (UE::GameFeaturesExtension::PooledComponents::MaxRegistrationsPerFrame <= 0)
+		{
+			AddComponent(Actor, EntryIndex, *ActiveData);
+			return;
+		}
+
+		const bool bAlreadyPending = ActiveData->PendingRegistrations.ContainsByPredicate([Actor, EntryIndex](const FPendingRegistration& Pending)
+			{
+				return (Pending.EntryIndex == EntryIndex) && (Pending.Actor == Actor);
+			});
+
+		if (!bAlreadyPending)
+		{
+			ActiveData->PendingRegistrations.Add({ Actor, EntryIndex });
+		}
+
+		if (!RegistrationTickerHandle.IsValid())
+		{
+			RegistrationTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::ProcessPendingRegistrations));
+		}
+	}
+}
+
+bool UGameFeatureAction_AddPooledComponents::ProcessPendingRegistrations(float DeltaTime)
+{
+	using namespace UE::GameFeaturesExtension::PooledComponents;
+
+	TRACE_GAMEFEATURESEXTENSION_SCOPE(TEXT("GameFeatureAction PendingRegistrations"));
+
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		BudgetUsed = 0;
+	}
+
+	const int32 Budget = MaxRegistrationsPerFrame > 0 ? MaxRegistrationsPerFrame : MAX_int32;
+
+	bool bHasPending = false;
+	ForEachContextState<FPerContextData>([this, Budget, &bHasPending](FPerContextData& ActiveData)
+		{
+			// Entries removed while pending are only invalidated, so registering can't shift the queue under us
+			int32 NumProcessed = 0;
+			while ((NumProcessed < ActiveData.PendingRegistrations.Num()) && (BudgetUsed < Budget))
+			{
+				const FPendingRegistration Pending = ActiveData.PendingRegistrations[NumProcessed++];
+				if (AActor* Actor = Pending.Actor.Get())
+				{
+					AddComponent(Actor, Pending.EntryIndex, ActiveData);
+					++BudgetUsed;
+				}
+			}
+
+			ActiveData.PendingRegistrations.RemoveAt(0, NumProcessed);
+			bHasPending |= !ActiveData.PendingRegistrations.IsEmpty();
+		});
+
+	if (!bHasPending)
+	{
+		RegistrationTickerHandle.Reset();
+	}
+
+	return bHasPending;
+}
+
+void UGameFeatureAction_AddPooledComponents::AddComponent(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
+{
+	if (!IsValid(Actor) || Actor->IsActorBeingDestroyed() || !ComponentList.IsValidIndex(EntryIndex))
+	{
+		return;
+	}
+
+	UClass* ComponentClass = ComponentList[EntryIndex].ComponentClass.Get();
+	if (ComponentClass == nullptr)
+	{
+		return;
+	}
+
+	TArray<FAddedComponent>& AddedComponents = ActiveData.ActorComponents.FindOrAdd(Actor);
+	const bool bAlreadyAdded = AddedComponents.ContainsByPredicate([EntryIndex](const FAddedComponent& Added)
+		{
+			return Added.EntryIndex == EntryIndex;
+		});
+
+	if (bAlreadyAdded)
+	{
+		return;
+	}
+
+	UActorComponent* Component = AcquireComponent(ComponentClass, Actor);
+	if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+	{
+		USceneComponent* RootComponent = Actor->GetRootComponent();
+		if (RootComponent && (RootComponent != SceneComponent))
+		{
+			SceneComponent->SetupAttachment(RootComponent);
+		}
+	}
+
+	// Initializes the component and begins play if the owner already has
+	Component->RegisterComponent();
+
+	AddedComponents.Add({ Component, EntryIndex });
+}
+
+void UGameFeatureAction_AddPooledComponents::RemoveComponents(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData)
+{
+	for (FPendingRegistration& Pending : ActiveData.PendingRegistrations)
+	{
+		if ((Pending.EntryIndex == EntryIndex) && (Pending.Actor == Actor))
+		{
+			Pending.Actor.Reset();
+		}
+	}
+
+	TArray<FAddedComponent>* AddedComponents = ActiveData.ActorComponents.Find(Actor);
+	if (AddedComponents == nullptr)
+	{
+		return;
+	}
+
+	for (int32 Index = AddedComponents->Num() - 1; Index >= 0; --Index)
+	{
+		if ((*AddedComponents)[Index].EntryIndex == EntryIndex)
+		{
+			UActorComponent* Component = (*AddedComponents)[Index].Component.Get();
+			AddedComponents->RemoveAtSwap(Index);
+			ReleaseComponent(Component);
+		}
+	}
+
+	if (AddedComponents->IsEmpty())
+	{
+		ActiveData.ActorComponents.Remove(Actor);
+	}
+}
+
+UActorComponent* UGameFeatureAction_AddPooledComponents::AcquireComponent(UClass* ComponentClass, AActor* Owner)
+{
+	if (FGameFeatureComponentPool* Pool = ComponentPools.Find(ComponentClass))
+	{
+		while (!Pool->Components.IsEmpty())
+		{
+			UActorComponent* Component = Pool->Components.Pop();
+			if (IsValid(Component))
+			{
+				// Moving the component into the actor also makes the actor its owner
+				Component->Rename(*MakeUniqueObjectName(Owner, ComponentClass).ToString(), Owner, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+				return Component;
+			}
+		}
+	}
+
+	return NewObject<UActorComponent>(Owner, ComponentClass, NAME_None, RF_Transient);
+}
+
+void UGameFeatureAction_AddPooledComponents::ReleaseComponent(UActorComponent* Component)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	FGameFeatureComponentPool& Pool = ComponentPools.FindOrAdd(Component->GetClass());
+
+	// Only classes that know how to reset themselves are reused, anything else would keep the previous owner's gameplay state.
+	// Replicated components carry net state tied to their owner and can't be moved to another one.
+	const bool bCanPool = Component->Implements<UGameFeaturePoolableComponent>() &&
+		!Component->GetIsReplicated() &&
+		(Pool.Components.Num() < UE::GameFeaturesExtension::PooledComponents::MaxPooledPerClass) &&
+		!Component->IsBeingDestroyed();
+
+	if (!bCanPool)
+	{
+		Component->DestroyComponent();
+		return;
+	}
+
+	if (USceneComponent* SceneComponent = Cast<USceneComponent>(Component))
+	{
+		SceneComponent->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	}
+
+	// Same teardown as DestroyComponent, minus the destruction
+	if (Component->HasBegunPlay())
+	{
+		Component->EndPlay(EEndPlayReason::RemovedFromWorld);
+	}
+
+	if (Component->IsRegistered())
+	{
+		Component->UnregisterComponent();
+	}
+
+	if (Component->HasBeenInitialized())
+	{
+		Component->UninitializeComponent();
+	}
+
+	UPackage* TransientPackage = GetTransientPackage();
+	Component->Rename(*MakeUniqueObjectName(TransientPackage, Component->GetClass()).ToString(), TransientPackage, REN_DontCreateRedirectors | REN_NonTransactional | REN_DoNotDirty);
+
+	IGameFeaturePoolableComponent::Execute_ResetForPool(Component);
+
+	Pool.Components.Add(Component);
+}
+
+#undef LOCTEXT_NAMESPACE
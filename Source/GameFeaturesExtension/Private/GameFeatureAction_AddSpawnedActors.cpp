@@ -24,15 +24,68 @@ struct FGameFeatureDeactivatingContext;
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
+#define ENGINE_VERSION_LATER_5_4 ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+
 //////////////////////////////////////////////////////////////////////
-// UGameFeatureAction_AddWorldSystem
+// FSpawningActorEntry
 
-void UGameFeatureAction_AddSpawnedActors::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+bool FSpawningActorEntry::ShouldSpawnForNetMode(ENetMode NetMode) const
 {
-	Super::OnGameFeatureDeactivating(Context);
-	Reset();
+	switch (NetPolicy)
+	{
+	case ESpawnedActorNetPolicy::ServerOnly:
+	case ESpawnedActorNetPolicy::AuthorityReplicated:
+		return NetMode != NM_Client;
+	case ESpawnedActorNetPolicy::ClientLocal:
+		return NetMode != NM_DedicatedServer;
+	default:
+		return true;
+	}
 }
 
+void FSpawningActorEntry::ApplyNetSettings(AActor& Actor) const
+{
+	switch (NetPolicy)
+	{
+	case ESpawnedActorNetPolicy::ServerOnly:
+	case ESpawnedActorNetPolicy::ClientLocal:
+		Actor.SetReplicates(false);
+		break;
+	case ESpawnedActorNetPolicy::AuthorityReplicated:
+		Actor.SetReplicates(true);
+		break;
+	default:
+		break;
+	}
+
+	if (bOverrideNetDormancy)
+	{
+		// Still deferred, so setting the initial value directly is enough
+		Actor.NetDormancy = NetDormancy;
+	}
+
+	if (bOverrideNetUpdateFrequency)
+	{
+#if ENGINE_VERSION_LATER_5_4
+		Actor.SetNetUpdateFrequency(NetUpdateFrequency);
+#else
+		Actor.NetUpdateFrequency = NetUpdateFrequency;
+#endif
+	}
+
+	if (bOverrideNetCullDistance)
+	{
+#if ENGINE_VERSION_LATER_5_4
+		Actor.SetNetCullDistanceSquared(FMath::Square(NetCullDistance));
+#else
+		Actor.NetCullDistanceSquared = FMath::Square(NetCullDistance);
+#endif
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_AddSpawnedActors
+
 #if WITH_EDITORONLY_DATA
 void UGameFeatureAction_AddSpawnedActors::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
 {
@@ -42,8 +95,21 @@ void UGameFeatureAction_AddSpawnedActors::AddAdditionalAssetBundleData(FAssetBun
 		{
 			for (const FSpawningActorEntry& ActorEntry : Entry.Actors)
 			{
-				AssetBundleData.AddBundleAssetTruncated(UGameFeaturesSubsystemSettings::LoadStateClient, ActorEntry.ActorType->GetPathName());
-				AssetBundleData.AddBundleAssetTruncated(UGameFeaturesSubsystemSettings::LoadStateServer, ActorEntry.ActorType->GetPathName());
+				if (ActorEntry.ActorType == nullptr)
+				{
+					continue;
+				}
+
+				// Actors that only exist on one side don't need their class loaded on the other
+				if (ActorEntry.NetPolicy != ESpawnedActorNetPolicy::ServerOnly)
+				{
+					AssetBundleData.AddBundleAssetTruncated(UGameFeaturesSubsystemSettings::LoadStateClient, ActorEntry.ActorType->GetPathName());
+				}
+
+				if (ActorEntry.NetPolicy != ESpawnedActorNetPolicy::ClientLocal)
+				{
+					AssetBundleData.AddBundleAssetTruncated(UGameFeaturesSubsystemSettings::LoadStateServer, ActorEntry.ActorType->GetPathName());
+				}
 			}
 		}
 	}
@@ -80,36 +146,161 @@ void UGameFeatureAction_AddSpawnedActors::OnAddToWorld(const FWorldContext& Worl
 
 	if ((World != nullptr) && World->IsGameWorld())
 	{
-		for (const FSpawningWorldActorsEntry& Entry : ActorsList)
+		FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+		TArray<const FSpawningActorEntry*> ActorEntries;
+		GatherEntriesForWorld(*World, ActorEntries);
+
+		for (const FSpawningActorEntry* ActorEntry : ActorEntries)
 		{
-			if (!Entry.TargetWorld.IsNull())
+			SpawnEntry(*World, *ActorEntry, HashEntry(*ActorEntry), ActiveData);
+		}
+	}
+}
+
+void UGameFeatureAction_AddSpawnedActors::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (FSpawnedActor& Spawned : ActiveData.SpawnedActors)
+	{
+		if (Spawned.Actor.IsValid())
+		{
+			Spawned.Actor->Destroy();
+		}
+	}
+
+	ActiveData.SpawnedActors.Empty();
+}
+
+bool UGameFeatureAction_AddSpawnedActors::SupportsIncrementalTeardown() const
+{
+	return true;
+}
+
+bool UGameFeatureAction_AddSpawnedActors::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// One actor per step, destroying an actor runs its EndPlay and can be arbitrarily expensive
+	if (!ActiveData.SpawnedActors.IsEmpty())
+	{
+		if (AActor* Actor = ActiveData.SpawnedActors.Pop(EAllowShrinking::No).Actor.Get())
+		{
+			Actor->Destroy();
+		}
+	}
+
+	return ActiveData.SpawnedActors.IsEmpty();
+}
+
+void UGameFeatureAction_AddSpawnedActors::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// Actors are destroyed along with their world, only forget about them
+	ActiveData.SpawnedActors.RemoveAllSwap([World](const FSpawnedActor& Spawned)
+		{
+			return !Spawned.Actor.IsValid() || Spawned.Actor->GetWorld() == World;
+		});
+}
+
+void UGameFeatureAction_AddSpawnedActors::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		Super::ReconcileContext(ChangeContext);
+		return;
+	}
+
+	// Actors destroyed by gameplay in the meantime count as not spawned
+	ActiveData->SpawnedActors.RemoveAllSwap([](const FSpawnedActor& Spawned)
+		{
+			return !Spawned.Actor.IsValid();
+		});
+
+	ForEachRelevantWorldContext(ChangeContext, [this, ActiveData](const FWorldContext& WorldContext)
+		{
+			UWorld* World = WorldContext.World();
+			if ((World == nullptr) || !World->IsGameWorld())
+			{
+				return;
+			}
+
+			TArray<const FSpawningActorEntry*> ActorEntries;
+			GatherEntriesForWorld(*World, ActorEntries);
+
+			TArray<uint32> DesiredHashes;
+			DesiredHashes.Reserve(ActorEntries.Num());
+			for (const FSpawningActorEntry* ActorEntry : ActorEntries)
 			{
-				UWorld* TargetWorld = Entry.TargetWorld.Get();
-				if (TargetWorld != World)
+				DesiredHashes.Add(HashEntry(*ActorEntry));
+			}
+
+			TArray<int32> AppliedIndices;
+			TArray<uint32> AppliedHashes;
+			for (int32 Index = 0; Index < ActiveData->SpawnedActors.Num(); ++Index)
+			{
+				if (ActiveData->SpawnedActors[Index].Actor->GetWorld() == World)
 				{
-					// This system is intended for a specific world (not this one)
-					continue;
+					AppliedIndices.Add(Index);
+					AppliedHashes.Add(ActiveData->SpawnedActors[Index].EntryHash);
 				}
 			}
 
-			for (const FSpawningActorEntry& ActorEntry : Entry.Actors)
+			TArray<int32> EntriesToSpawn;
+			TArray<int32> ActorsToDestroy;
+			DiffEntryHashes(AppliedHashes, DesiredHashes, EntriesToSpawn, ActorsToDestroy);
+
+			for (const int32 AppliedIndex : ActorsToDestroy)
 			{
-				AActor* NewActor = World->SpawnActor<AActor>(ActorEntry.ActorType, ActorEntry.SpawnTransform);
-				SpawnedActors.Add(NewActor);
+				const int32 Index = AppliedIndices[AppliedIndex];
+				ActiveData->SpawnedActors[Index].Actor->Destroy();
+				ActiveData->SpawnedActors.RemoveAtSwap(Index);
 			}
-		}
-	}
+
+			for (const int32 EntryIndex : EntriesToSpawn)
+			{
+				SpawnEntry(*World, *ActorEntries[EntryIndex], DesiredHashes[EntryIndex], *ActiveData);
+			}
+		});
 }
 
-void UGameFeatureAction_AddSpawnedActors::Reset()
+void UGameFeatureAction_AddSpawnedActors::GatherEntriesForWorld(UWorld& World, TArray<const FSpawningActorEntry*>& OutEntries) const
 {
-	for (TWeakObjectPtr<AActor>& ActorPtr : SpawnedActors)
+	for (const FSpawningWorldActorsEntry& Entry : ActorsList)
 	{
-		if (ActorPtr.IsValid())
+		if (!Entry.TargetWorld.IsNull())
+		{
+			UWorld* TargetWorld = Entry.TargetWorld.Get();
+			if (TargetWorld != &World)
+			{
+				// This system is intended for a specific world (not this one)
+				continue;
+			}
+		}
+
+		for (const FSpawningActorEntry& ActorEntry : Entry.Actors)
 		{
-			ActorPtr->Destroy();
+			if (ActorEntry.ActorType && ActorEntry.ShouldSpawnForNetMode(World.GetNetMode()))
+			{
+				OutEntries.Add(&ActorEntry);
+			}
 		}
 	}
 }
 
+void UGameFeatureAction_AddSpawnedActors::SpawnEntry(UWorld& World, const FSpawningActorEntry& ActorEntry, uint32 EntryHash, FPerContextData& ActiveData)
+{
+	// Defer so networking settings are in place before the actor is initialized for replication
+	if (AActor* NewActor = World.SpawnActorDeferred<AActor>(ActorEntry.ActorType, ActorEntry.SpawnTransform))
+	{
+		ActorEntry.ApplyNetSettings(*NewActor);
+		NewActor->FinishSpawning(ActorEntry.SpawnTransform);
+		ActiveData.SpawnedActors.Add({ NewActor, EntryHash });
+	}
+}
+
+#undef ENGINE_VERSION_LATER_5_4
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
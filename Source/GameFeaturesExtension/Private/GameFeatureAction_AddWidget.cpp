@@ -10,23 +10,22 @@
 #include "CommonActivatableWidget.h"
 #include "CommonLocalPlayer.h"
 #include "CommonUIExtensions.h"
+#include "GameFeaturesExtensionStats.h"
+#include "GameFeatureActivationTrace.h"
+#include "GameFeatureStreamingManager.h"
 #include "GameFeaturesSubsystemSettings.h"
 #include "Components/GameFrameworkComponentManager.h"
+#include "Engine/StreamableManager.h"
 #include "GameFramework/HUD.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddWidget)
 
 #define LOCTEXT_NAMESPACE "GameFeatures"
 
-void UGameFeatureAction_AddWidget::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+EGameFeatureActionNetExecution UGameFeatureAction_AddWidget::GetNetExecution() const
 {
-	Super::OnGameFeatureDeactivating(Context);
-
-	FPerContextData* ActiveData = ContextData.Find(Context);
-	if (ensure(ActiveData))
-	{
-		Reset(*ActiveData);
-	}
+	// Widgets only exist for local players
+	return EGameFeatureActionNetExecution::ClientOnly;
 }
 
 #if WITH_EDITORONLY_DATA
@@ -87,69 +86,198 @@ EDataValidationResult UGameFeatureAction_AddWidget::IsDataValid(class FDataValid
 }
 #endif
 
+void UGameFeatureAction_AddWidget::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for (const FGameFeatureWidgetLayoutRequest& Entry : Layouts)
+	{
+		OutAssets.Add(Entry.LayoutClass.ToSoftObjectPath());
+	}
+
+	for (const FGameFeatureWidgetHUDElementRequest& Entry : Widgets)
+	{
+		OutAssets.Add(Entry.WidgetClass.ToSoftObjectPath());
+	}
+}
+
 void UGameFeatureAction_AddWidget::OnAddToWorld(
 	const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
 {
+#if !UE_SERVER
 	const UWorld* World = WorldContext.World();
-	const UGameInstance* GameInstance = World->GetGameInstance();
-	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
 
 	if ((GameInstance != nullptr) &&
 		(World != nullptr) &&
 		(World->IsGameWorld()))
 	{
-		if (UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance))
+		FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+		// HUDs are only extended from the load callback, so a pending class is never loaded on demand
+		LoadClasses(ActiveData, FStreamableDelegate::CreateUObject(this, &ThisClass::HandleWidgetClassesLoaded, MakeWeakObjectPtr(GameInstance), ChangeContext));
+	}
+#endif
+}
+
+void UGameFeatureAction_AddWidget::GatherClassesToLoad(TArray<FSoftObjectPath>& OutClasses) const
+{
+	for (const FGameFeatureWidgetLayoutRequest& Entry : Layouts)
+	{
+		if (Entry.LayoutClass.IsPending())
 		{
-			TSoftClassPtr<AActor> HUDClass = AHUD::StaticClass();
-			TSharedPtr<FComponentRequestHandle> ExtensionRequestHandle = ComponentManager->AddExtensionHandler
-			(
-				HUDClass,
-				UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, ChangeContext)
-			);
+			OutClasses.AddUnique(Entry.LayoutClass.ToSoftObjectPath());
+		}
+	}
 
-			ActiveData.ComponentRequests.Add(ExtensionRequestHandle);
+	for (const FGameFeatureWidgetHUDElementRequest& Entry : Widgets)
+	{
+		if (Entry.WidgetClass.IsPending())
+		{
+			OutClasses.AddUnique(Entry.WidgetClass.ToSoftObjectPath());
 		}
 	}
 }
 
+void UGameFeatureAction_AddWidget::LoadClasses(FPerContextData& ActiveData, FStreamableDelegate&& OnLoaded)
+{
+	TArray<FSoftObjectPath> ClassesToLoad;
+	GatherClassesToLoad(ClassesToLoad);
+
+	if (ClassesToLoad.IsEmpty())
+	{
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(ClassesToLoad), EGameFeatureStreamingPriority::Visual, MoveTemp(OnLoaded), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		ActiveData.LoadHandles.Add(LoadHandle);
+	}
+}
+
+void UGameFeatureAction_AddWidget::HandleWidgetClassesLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext)
+{
+	UGameInstance* GameInstance = WeakGameInstance.Get();
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+
+	if ((GameInstance == nullptr) || (ActiveData == nullptr))
+	{
+		return;
+	}
+
+	if (UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance))
+	{
+		TSoftClassPtr<AActor> HUDClass = AHUD::StaticClass();
+		TSharedPtr<FComponentRequestHandle> ExtensionRequestHandle = ComponentManager->AddExtensionHandler
+		(
+			HUDClass,
+			UGameFrameworkComponentManager::FExtensionHandlerDelegate::CreateUObject(this, &ThisClass::HandleActorExtension, ChangeContext)
+		);
+
+		ActiveData->ComponentRequests.Add(ExtensionRequestHandle);
+	}
+}
+
+void UGameFeatureAction_AddWidget::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	Reset(static_cast<FPerContextData&>(ContextState));
+}
+
 void UGameFeatureAction_AddWidget::Reset(FPerContextData& ActiveData)
 {
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : ActiveData.LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	ActiveData.LoadHandles.Empty();
+
 	ActiveData.ComponentRequests.Empty();
 
 	for (auto& Pair : ActiveData.ActorData)
 	{
-		for (FUIExtensionHandle& Handle : Pair.Value.ExtensionHandles)
+		for (FAddedLayout& Added : Pair.Value.LayoutsAdded)
 		{
-			Handle.Unregister();
+			if (Added.Widget.IsValid())
+			{
+				Added.Widget->DeactivateWidget();
+			}
+		}
+
+		for (FAddedHUDElement& Added : Pair.Value.ExtensionHandles)
+		{
+			Added.Handle.Unregister();
 		}
 	}
 
-	ActiveData.ActorData.Reset();
+	ActiveData.ActorData.Empty();
+}
+
+void UGameFeatureAction_AddWidget::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		Super::ReconcileContext(ChangeContext);
+		return;
+	}
+
+	// Edited entries may reference classes that aren't loaded yet, update the HUDs once they are
+	LoadClasses(*ActiveData, FStreamableDelegate::CreateUObject(this, &ThisClass::HandleReconcileClassesLoaded, ChangeContext));
+}
+
+void UGameFeatureAction_AddWidget::HandleReconcileClassesLoaded(FGameFeatureStateChangeContext ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return;
+	}
+
+	// The HUD extension handlers stay registered, only the widgets of HUDs that already received them need updating
+	for (auto& Pair : ActiveData->ActorData)
+	{
+		if (AActor* Actor = Cast<AActor>(Pair.Key.ResolveObjectPtr()))
+		{
+			ReconcileWidgets(Actor, Pair.Value);
+		}
+	}
 }
 
 void UGameFeatureAction_AddWidget::HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext)
 {
-	FPerContextData& ActiveData = ContextData.FindOrAdd(ChangeContext);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Extension"), TEXT("%s %s %s %s"), *GetPackage()->GetName(), *GetClass()->GetName(), *EventName.ToString(), *GetNameSafe(Actor));
+	RECORD_GAMEFEATURE_EXTENSION_EVENT(Actor, EventName);
+
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return;
+	}
 
 	if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionRemoved) ||
 		(EventName == UGameFrameworkComponentManager::NAME_ReceiverRemoved))
 	{
-		RemoveWidgets(Actor, ActiveData);
+		RemoveWidgets(Actor, *ActiveData);
 	}
 	else if ((EventName == UGameFrameworkComponentManager::NAME_ExtensionAdded) ||
 		(EventName == UGameFrameworkComponentManager::NAME_GameActorReady))
 	{
-		AddWidgets(Actor, ActiveData);
+		AddWidgets(Actor, *ActiveData);
 	}
 }
 
-void UGameFeatureAction_AddWidget::AddWidgets(AActor* Actor, FPerContextData& ActiveData)
+UCommonLocalPlayer* UGameFeatureAction_AddWidget::GetLocalPlayerForHUD(const AActor* Actor)
 {
 	const AHUD* HUD = CastChecked<AHUD>(Actor);
 
 	if (!HUD->GetOwningPlayerController())
 	{
-		return;
+		return nullptr;
 	}
 
 	UWorld* const World = HUD->GetWorld();
@@ -157,31 +285,122 @@ void UGameFeatureAction_AddWidget::AddWidgets(AActor* Actor, FPerContextData& Ac
 		(World->WorldType == EWorldType::EditorPreview) ||
 		(World->WorldType == EWorldType::GamePreview))
 	{
-		return;
+		return nullptr;
 	}
-	
-	if (UCommonLocalPlayer* LP = Cast<UCommonLocalPlayer>(HUD->GetOwningPlayerController()->Player))
+
+	return Cast<UCommonLocalPlayer>(HUD->GetOwningPlayerController()->Player);
+}
+
+void UGameFeatureAction_AddWidget::AddWidgets(AActor* Actor, FPerContextData& ActiveData)
+{
+	if (UCommonLocalPlayer* LP = GetLocalPlayerForHUD(Actor))
 	{
 		FPerActorData& ActorData = ActiveData.ActorData.FindOrAdd(Actor);
 
 		// Push Layers
 		for (const auto& Entry : Layouts)
 		{
-			if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.LoadSynchronous())
+			AddLayout(LP, Entry, HashEntry(Entry), ActorData);
+		}
+
+		// Add Widgets
+		for (const auto& Entry : Widgets)
+		{
+			AddHUDElement(LP, Entry, HashEntry(Entry), ActorData);
+		}
+	}
+}
+
+void UGameFeatureAction_AddWidget::ReconcileWidgets(AActor* Actor, FPerActorData& ActorData)
+{
+	UCommonLocalPlayer* LP = GetLocalPlayerForHUD(Actor);
+	if (LP == nullptr)
+	{
+		return;
+	}
+
+	{ // Layouts
+		TArray<uint32> AppliedHashes;
+		for (const FAddedLayout& Added : ActorData.LayoutsAdded)
+		{
+			AppliedHashes.Add(Added.EntryHash);
+		}
+
+		TArray<uint32> DesiredHashes;
+		for (const auto& Entry : Layouts)
+		{
+			DesiredHashes.Add(HashEntry(Entry));
+		}
+
+		TArray<int32> EntriesToAdd;
+		TArray<int32> LayoutsToRemove;
+		DiffEntryHashes(AppliedHashes, DesiredHashes, EntriesToAdd, LayoutsToRemove);
+
+		for (const int32 Index : LayoutsToRemove)
+		{
+			if (ActorData.LayoutsAdded[Index].Widget.IsValid())
 			{
-				ActorData.LayoutsAdded.Add(UCommonUIExtensions::PushContentToLayer_ForPlayer(LP, Entry.LayerTag, ConcreteWidgetClass));
+				ActorData.LayoutsAdded[Index].Widget->DeactivateWidget();
 			}
+			ActorData.LayoutsAdded.RemoveAtSwap(Index);
 		}
 
-		// Add Widgets
-		UUIExtensionSubsystem* ExtensionSub = HUD->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+		for (const int32 EntryIndex : EntriesToAdd)
+		{
+			AddLayout(LP, Layouts[EntryIndex], DesiredHashes[EntryIndex], ActorData);
+		}
+	}
+
+	{ // Widgets
+		TArray<uint32> AppliedHashes;
+		for (const FAddedHUDElement& Added : ActorData.ExtensionHandles)
+		{
+			AppliedHashes.Add(Added.EntryHash);
+		}
+
+		TArray<uint32> DesiredHashes;
 		for (const auto& Entry : Widgets)
 		{
-			ActorData.ExtensionHandles.Add(ExtensionSub->RegisterExtensionAsWidgetForContext(Entry.SlotTag, LP, Entry.WidgetClass.Get(), Entry.Priority));
+			DesiredHashes.Add(HashEntry(Entry));
+		}
+
+		TArray<int32> EntriesToAdd;
+		TArray<int32> WidgetsToRemove;
+		DiffEntryHashes(AppliedHashes, DesiredHashes, EntriesToAdd, WidgetsToRemove);
+
+		for (const int32 Index : WidgetsToRemove)
+		{
+			ActorData.ExtensionHandles[Index].Handle.Unregister();
+			ActorData.ExtensionHandles.RemoveAtSwap(Index);
+		}
+
+		for (const int32 EntryIndex : EntriesToAdd)
+		{
+			AddHUDElement(LP, Widgets[EntryIndex], DesiredHashes[EntryIndex], ActorData);
 		}
 	}
 }
 
+void UGameFeatureAction_AddWidget::AddLayout(UCommonLocalPlayer* LocalPlayer, const FGameFeatureWidgetLayoutRequest& Entry, uint32 EntryHash, FPerActorData& ActorData)
+{
+	if (TSubclassOf<UCommonActivatableWidget> ConcreteWidgetClass = Entry.LayoutClass.Get())
+	{
+		ActorData.LayoutsAdded.Add({ UCommonUIExtensions::PushContentToLayer_ForPlayer(LocalPlayer, Entry.LayerTag, ConcreteWidgetClass), EntryHash });
+	}
+}
+
+void UGameFeatureAction_AddWidget::AddHUDElement(UCommonLocalPlayer* LocalPlayer, const FGameFeatureWidgetHUDElementRequest& Entry, uint32 EntryHash, FPerActorData& ActorData)
+{
+	TSubclassOf<UUserWidget> ConcreteWidgetClass = Entry.WidgetClass.Get();
+	if (ConcreteWidgetClass == nullptr)
+	{
+		return;
+	}
+
+	UUIExtensionSubsystem* ExtensionSub = LocalPlayer->GetWorld()->GetSubsystem<UUIExtensionSubsystem>();
+	ActorData.ExtensionHandles.Add({ ExtensionSub->RegisterExtensionAsWidgetForContext(Entry.SlotTag, LocalPlayer, ConcreteWidgetClass, Entry.Priority), EntryHash });
+}
+
 void UGameFeatureAction_AddWidget::RemoveWidgets(AActor* Actor, FPerContextData& ActiveData)
 {
 	const AHUD* HUD = CastChecked<AHUD>(Actor);
@@ -194,17 +413,17 @@ void UGameFeatureAction_AddWidget::RemoveWidgets(AActor* Actor, FPerContextData&
 		return;
 	}
 
-	for (TWeakObjectPtr<UCommonActivatableWidget>& Added : ActorData->LayoutsAdded)
+	for (FAddedLayout& Added : ActorData->LayoutsAdded)
 	{
-		if (Added.IsValid())
+		if (Added.Widget.IsValid())
 		{
-			Added->DeactivateWidget();
+			Added.Widget->DeactivateWidget();
 		}
 	}
 
-	for (FUIExtensionHandle& Handle : ActorData->ExtensionHandles)
+	for (FAddedHUDElement& Added : ActorData->ExtensionHandles)
 	{
-		Handle.Unregister();
+		Added.Handle.Unregister();
 	}
 
 	ActiveData.ActorData.Remove(HUD);
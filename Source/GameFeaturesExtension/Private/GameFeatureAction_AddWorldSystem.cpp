@@ -36,12 +36,6 @@ void UGameFeatureWorldSystem::NativeInitialize(
 //////////////////////////////////////////////////////////////////////
 // UGameFeatureAction_AddWorldSystem
 
-void UGameFeatureAction_AddWorldSystem::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
-{
-	Super::OnGameFeatureDeactivating(Context);
-	Reset();
-}
-
 #if WITH_EDITORONLY_DATA
 void UGameFeatureAction_AddWorldSystem::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
 {
@@ -112,56 +106,155 @@ void UGameFeatureAction_AddWorldSystem::OnAddToWorld(const FWorldContext& WorldC
 		UGameFeatureWorldSystemManager* SystemManager = World->GetSubsystem<UGameFeatureWorldSystemManager>();
 		if (ensure(SystemManager))
 		{
-			for (const FGameFeatureWorldSystemEntry& Entry : WorldSystemsList)
+			FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+			TArray<const FGameFeatureWorldSystemEntry*> Entries;
+			GatherEntriesForWorld(*World, Entries);
+
+			for (const FGameFeatureWorldSystemEntry* Entry : Entries)
 			{
-				if (!Entry.TargetWorld.IsNull())
-				{
-					UWorld* TargetWorld = Entry.TargetWorld.Get();
-					if (TargetWorld != World)
-					{
-						// This system is intended for a specific world (not this one)
-						continue;
-					}
-				}
+				SystemManager->RequestSystemOfType(Entry->SystemType);
+				ActiveData.RequestedSystems.Add({ World, Entry->SystemType, HashEntry(*Entry) });
+			}
+		}
+	}
+}
 
-				if (Entry.SystemType)
-				{
-					SystemManager->RequestSystemOfType(Entry.SystemType);
-				}
+void UGameFeatureAction_AddWorldSystem::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (const FRequestedSystem& Request : ActiveData.RequestedSystems)
+	{
+		if (UWorld* World = Request.World.Get())
+		{
+			if (UGameFeatureWorldSystemManager* SystemManager = World->GetSubsystem<UGameFeatureWorldSystemManager>())
+			{
+				SystemManager->ReleaseRequestForSystemOfType(Request.SystemType);
 			}
 		}
 	}
+
+	ActiveData.RequestedSystems.Empty();
+}
+
+bool UGameFeatureAction_AddWorldSystem::SupportsIncrementalTeardown() const
+{
+	return true;
 }
 
-void UGameFeatureAction_AddWorldSystem::Reset()
+bool UGameFeatureAction_AddWorldSystem::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
 {
-	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// Releasing the last request deinitializes the system, one per step
+	if (!ActiveData.RequestedSystems.IsEmpty())
 	{
-		UWorld* World = WorldContext.World();
-		if (World)
+		const FRequestedSystem Request = ActiveData.RequestedSystems.Pop(EAllowShrinking::No);
+		if (UWorld* World = Request.World.Get())
 		{
 			if (UGameFeatureWorldSystemManager* SystemManager = World->GetSubsystem<UGameFeatureWorldSystemManager>())
 			{
-				for (const FGameFeatureWorldSystemEntry& Entry : WorldSystemsList)
-				{
-					if (!Entry.TargetWorld.IsNull())
-					{
-						UWorld* TargetWorld = Entry.TargetWorld.Get();
-						if (TargetWorld != World)
-						{
-							// This system is intended for a specific world (not this one)
-							continue;
-						}
-					}
+				SystemManager->ReleaseRequestForSystemOfType(Request.SystemType);
+			}
+		}
+	}
 
-					if (Entry.SystemType)
-					{
-						SystemManager->ReleaseRequestForSystemOfType(Entry.SystemType);
-					}
+	return ActiveData.RequestedSystems.IsEmpty();
+}
+
+void UGameFeatureAction_AddWorldSystem::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// The manager and its systems go away with the world, only forget about the requests
+	ActiveData.RequestedSystems.RemoveAllSwap([World](const FRequestedSystem& Request)
+		{
+			return !Request.World.IsValid() || Request.World.Get() == World;
+		});
+}
+
+void UGameFeatureAction_AddWorldSystem::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		Super::ReconcileContext(ChangeContext);
+		return;
+	}
+
+	ForEachRelevantWorldContext(ChangeContext, [this, ActiveData](const FWorldContext& WorldContext)
+		{
+			UWorld* World = WorldContext.World();
+			UGameFeatureWorldSystemManager* SystemManager = World ? World->GetSubsystem<UGameFeatureWorldSystemManager>() : nullptr;
+			if ((SystemManager == nullptr) || !World->IsGameWorld())
+			{
+				return;
+			}
+
+			TArray<const FGameFeatureWorldSystemEntry*> Entries;
+			GatherEntriesForWorld(*World, Entries);
+
+			TArray<uint32> DesiredHashes;
+			DesiredHashes.Reserve(Entries.Num());
+			for (const FGameFeatureWorldSystemEntry* Entry : Entries)
+			{
+				DesiredHashes.Add(HashEntry(*Entry));
+			}
+
+			TArray<int32> AppliedIndices;
+			TArray<uint32> AppliedHashes;
+			for (int32 Index = 0; Index < ActiveData->RequestedSystems.Num(); ++Index)
+			{
+				if (ActiveData->RequestedSystems[Index].World.Get() == World)
+				{
+					AppliedIndices.Add(Index);
+					AppliedHashes.Add(ActiveData->RequestedSystems[Index].EntryHash);
 				}
+			}
+
+			TArray<int32> EntriesToRequest;
+			TArray<int32> RequestsToRelease;
+			DiffEntryHashes(AppliedHashes, DesiredHashes, EntriesToRequest, RequestsToRelease);
 
+			// Request first, so a system whose entry only changed cosmetically keeps its instance
+			for (const int32 EntryIndex : EntriesToRequest)
+			{
+				SystemManager->RequestSystemOfType(Entries[EntryIndex]->SystemType);
+			}
+
+			for (const int32 AppliedIndex : RequestsToRelease)
+			{
+				const int32 Index = AppliedIndices[AppliedIndex];
+				SystemManager->ReleaseRequestForSystemOfType(ActiveData->RequestedSystems[Index].SystemType);
+				ActiveData->RequestedSystems.RemoveAtSwap(Index);
+			}
+
+			for (const int32 EntryIndex : EntriesToRequest)
+			{
+				ActiveData->RequestedSystems.Add({ World, Entries[EntryIndex]->SystemType, DesiredHashes[EntryIndex] });
+			}
+		});
+}
+
+void UGameFeatureAction_AddWorldSystem::GatherEntriesForWorld(UWorld& World, TArray<const FGameFeatureWorldSystemEntry*>& OutEntries) const
+{
+	for (const FGameFeatureWorldSystemEntry& Entry : WorldSystemsList)
+	{
+		if (!Entry.TargetWorld.IsNull())
+		{
+			UWorld* TargetWorld = Entry.TargetWorld.Get();
+			if (TargetWorld != &World)
+			{
+				// This system is intended for a specific world (not this one)
+				continue;
 			}
 		}
+
+		if (Entry.SystemType)
+		{
+			OutEntries.Add(&Entry);
+		}
 	}
 }
 
@@ -215,6 +308,8 @@ void UGameFeatureWorldSystemManager::ReleaseRequestForSystemOfType(TSubclassOf<U
 
 			if (PreExistingInstance.Value <= 0)
 			{
+				// Only drops the manager's reference, blueprints may still hold the system from FindGameFeatureWorldSystemOfType.
+				// It's collected once it becomes unreachable.
 				SystemInstances.Remove(PreExistingInstance.Key);
 			}
 			break;
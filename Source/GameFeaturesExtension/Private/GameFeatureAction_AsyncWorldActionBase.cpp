@@ -0,0 +1,258 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#include "GameFeatureAction_AsyncWorldActionBase.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/World.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AsyncWorldActionBase)
+
+//////////////////////////////////////////////////////////////////////
+// FGameFeatureAsyncOperation
+
+bool FGameFeatureAsyncOperation::IsCancelled() const
+{
+	if (bCancelled || !Owner.IsValid())
+	{
+		return true;
+	}
+
+	const UWorld* WorldPtr = World.Get();
+	return !WorldPtr || WorldPtr->bIsTearingDown;
+}
+
+void FGameFeatureAsyncOperation::Cancel()
+{
+	if (bCancelled)
+	{
+		return;
+	}
+
+	// The coroutine frame holds a reference to this operation, keep it alive until the frame is gone
+	TSharedRef<FGameFeatureAsyncOperation> KeepAlive = AsShared();
+	bCancelled = true;
+
+	if (TFunction<void()> OnCancel = MoveTemp(CancelPending))
+	{
+		OnCancel();
+	}
+
+	// Cancelling from within the coroutine itself leaves the frame alone, it's destroyed at its next suspension point instead
+	if (std::coroutine_handle<> Handle = std::exchange(Suspended, nullptr))
+	{
+		Handle.destroy();
+	}
+}
+
+void FGameFeatureAsyncOperation::Suspend(std::coroutine_handle<> Handle, TFunction<void()>&& OnCancel)
+{
+	check(!Suspended);
+
+	if (IsCancelled())
+	{
+		bCancelled = true;
+		OnCancel();
+		Handle.destroy();
+		return;
+	}
+
+	Suspended = Handle;
+	CancelPending = MoveTemp(OnCancel);
+}
+
+void FGameFeatureAsyncOperation::Resume()
+{
+	std::coroutine_handle<> Handle = std::exchange(Suspended, nullptr);
+	if (!Handle)
+	{
+		return;
+	}
+
+	CancelPending.Reset();
+
+	if (IsCancelled())
+	{
+		TSharedRef<FGameFeatureAsyncOperation> KeepAlive = AsShared();
+		bCancelled = true;
+		Handle.destroy();
+		return;
+	}
+
+	Handle.resume();
+}
+
+//////////////////////////////////////////////////////////////////////
+// FGameFeatureAsyncContext
+
+bool FGameFeatureAsyncContext::FAssetsAwaiter::await_ready() const
+{
+	// Nothing to wait for if everything is resident already, e.g. because the feature prewarmed it
+	return !Assets.ContainsByPredicate([](const FSoftObjectPath& Path) { return Path.ResolveObject() == nullptr; });
+}
+
+bool FGameFeatureAsyncContext::FAssetsAwaiter::await_suspend(std::coroutine_handle<> Coroutine)
+{
+	TSharedRef<FGameFeatureAsyncOperation> Op = Operation;
+
+	// Only set while the coroutine is suspended on this awaiter. The completion delegate may still fire after the load
+	// completed synchronously, by then the coroutine may be suspended on a later awaiter it must not resume.
+	TSharedRef<bool> bIsWaiting = MakeShared<bool>(false);
+
+	Handle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(MoveTemp(Assets), Priority,
+		FStreamableDelegate::CreateLambda([WeakOp = Op.ToWeakPtr(), bIsWaiting]()
+			{
+				if (!std::exchange(*bIsWaiting, false))
+				{
+					return;
+				}
+
+				if (TSharedPtr<FGameFeatureAsyncOperation> PinnedOp = WeakOp.Pin())
+				{
+					PinnedOp->Resume();
+				}
+			}),
+		TEXT("GameFeatureAsyncOperation"));
+
+	if (!Handle.IsValid() || Handle->HasLoadCompleted())
+	{
+		// Completed synchronously, continue without suspending
+		return false;
+	}
+
+	*bIsWaiting = true;
+
+	// May destroy the coroutine frame and with it this awaiter if the operation was cancelled meanwhile
+	Op->Suspend(Coroutine, [LoadHandle = Handle, bIsWaiting]()
+		{
+			*bIsWaiting = false;
+			LoadHandle->CancelHandle();
+		});
+	return true;
+}
+
+bool FGameFeatureAsyncContext::FLevelAwaiter::await_ready() const
+{
+	const ULevelStreaming* Level = LevelStreaming.Get();
+	return !Level || Level->IsLevelVisible();
+}
+
+bool FGameFeatureAsyncContext::FLevelAwaiter::await_resume() const
+{
+	// await_ready is also true once the streaming level went away, only report success if the level is actually there
+	const ULevelStreaming* Level = LevelStreaming.Get();
+	return Level && Level->IsLevelVisible();
+}
+
+void FGameFeatureAsyncContext::FLevelAwaiter::await_suspend(std::coroutine_handle<> Coroutine)
+{
+	TSharedRef<FGameFeatureAsyncOperation> Op = Operation;
+	const FTSTicker::FDelegateHandle TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakOp = Op.ToWeakPtr(), WeakLevel = LevelStreaming](float)
+		{
+			const ULevelStreaming* Level = WeakLevel.Get();
+			if (Level && !Level->IsLevelVisible())
+			{
+				return true;
+			}
+
+			if (TSharedPtr<FGameFeatureAsyncOperation> PinnedOp = WeakOp.Pin())
+			{
+				PinnedOp->Resume();
+			}
+			return false;
+		}));
+
+	Op->Suspend(Coroutine, [TickerHandle]()
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		});
+}
+
+void FGameFeatureAsyncContext::FDelayAwaiter::await_suspend(std::coroutine_handle<> Coroutine)
+{
+	TSharedRef<FGameFeatureAsyncOperation> Op = Operation;
+	const FTSTicker::FDelegateHandle TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+		[WeakOp = Op.ToWeakPtr()](float)
+		{
+			if (TSharedPtr<FGameFeatureAsyncOperation> PinnedOp = WeakOp.Pin())
+			{
+				PinnedOp->Resume();
+			}
+			return false;
+		}), Seconds);
+
+	Op->Suspend(Coroutine, [TickerHandle]()
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		});
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_AsyncWorldActionBase
+
+void UGameFeatureAction_AsyncWorldActionBase::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+{
+	// Stop pending work first, so the context state is only torn down once nothing adds to it anymore
+	CancelAsyncOperations(Context);
+
+	Super::OnGameFeatureDeactivating(Context);
+}
+
+int32 UGameFeatureAction_AsyncWorldActionBase::GetNumPendingAsyncOperations() const
+{
+	int32 NumPending = 0;
+	for (const TPair<FGameFeatureStateChangeContext, TArray<TWeakPtr<FGameFeatureAsyncOperation>>>& Pair : AsyncOperations)
+	{
+		for (const TWeakPtr<FGameFeatureAsyncOperation>& WeakOp : Pair.Value)
+		{
+			const TSharedPtr<FGameFeatureAsyncOperation> Op = WeakOp.Pin();
+			NumPending += (Op.IsValid() && Op->IsSuspended()) ? 1 : 0;
+		}
+	}
+	return NumPending;
+}
+
+void UGameFeatureAction_AsyncWorldActionBase::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	TSharedRef<FGameFeatureAsyncOperation> Operation = MakeShared<FGameFeatureAsyncOperation>(*this, WorldContext.World());
+
+	// Runs until the first suspension point right away, operations that never suspend are gone before they would be tracked
+	OnAddToWorldAsync(FGameFeatureAsyncContext(Operation, ChangeContext));
+
+	if (Operation->IsSuspended())
+	{
+		TArray<TWeakPtr<FGameFeatureAsyncOperation>>& Operations = AsyncOperations.FindOrAdd(ChangeContext);
+		Operations.RemoveAllSwap([](const TWeakPtr<FGameFeatureAsyncOperation>& WeakOp) { return !WeakOp.IsValid(); }, EAllowShrinking::No);
+		Operations.Add(Operation);
+	}
+}
+
+void UGameFeatureAction_AsyncWorldActionBase::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	CancelAsyncOperations(ChangeContext);
+
+	Super::ReconcileContext(ChangeContext);
+}
+
+void UGameFeatureAction_AsyncWorldActionBase::DescribeRuntime(FStringBuilderBase& Out) const
+{
+	Out.Appendf(TEXT("PendingAsync=%d"), GetNumPendingAsyncOperations());
+}
+
+void UGameFeatureAction_AsyncWorldActionBase::CancelAsyncOperations(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	TArray<TWeakPtr<FGameFeatureAsyncOperation>> Operations;
+	if (!AsyncOperations.RemoveAndCopyValue(ChangeContext, Operations))
+	{
+		return;
+	}
+
+	for (const TWeakPtr<FGameFeatureAsyncOperation>& WeakOp : Operations)
+	{
+		if (TSharedPtr<FGameFeatureAsyncOperation> Op = WeakOp.Pin())
+		{
+			Op->Cancel();
+		}
+	}
+}
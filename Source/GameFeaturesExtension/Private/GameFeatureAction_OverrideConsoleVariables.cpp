@@ -0,0 +1,266 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureAction_OverrideConsoleVariables.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_OverrideConsoleVariables)
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+TMap<FString, UGameFeatureAction_OverrideConsoleVariables::FVariableVotes> UGameFeatureAction_OverrideConsoleVariables::GlobalVotes;
+uint64 UGameFeatureAction_OverrideConsoleVariables::LastVoteId = 0;
+
+#if WITH_EDITOR
+EDataValidationResult UGameFeatureAction_OverrideConsoleVariables::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	int32 EntryIndex = 0;
+	for (const FGameFeatureConsoleVariableOverride& Entry : ConsoleVariables)
+	{
+		if (Entry.Name.IsEmpty())
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("EmptyConsoleVariableName", "Empty Name at index {0} in ConsoleVariables."), FText::AsNumber(EntryIndex)));
+		}
+		else if (const IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Entry.Name))
+		{
+			if (Variable->TestFlags(ECVF_ReadOnly))
+			{
+				Result = EDataValidationResult::Invalid;
+				Context.AddError(FText::Format(LOCTEXT("ReadOnlyConsoleVariable", "Console variable {0} at index {1} in ConsoleVariables is read only."),
+					FText::FromString(Entry.Name), FText::AsNumber(EntryIndex)));
+			}
+		}
+		else
+		{
+			// May be registered by a module that isn't loaded in the editor
+			Context.AddWarning(FText::Format(LOCTEXT("UnknownConsoleVariable", "Console variable {0} at index {1} in ConsoleVariables doesn't exist in the editor."),
+				FText::FromString(Entry.Name), FText::AsNumber(EntryIndex)));
+		}
+
+		++EntryIndex;
+	}
+
+	return Result;
+}
+#endif
+
+void UGameFeatureAction_OverrideConsoleVariables::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	// Only games vote, the editor world would otherwise override the variables for the editor itself
+	const UWorld* World = WorldContext.World();
+	if ((WorldContext.OwningGameInstance == nullptr) || (World == nullptr) || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+	if (ActiveData.bVoted)
+	{
+		// Already voted for another world of this context
+		return;
+	}
+	ActiveData.bVoted = true;
+
+	for (const FGameFeatureConsoleVariableOverride& Entry : ConsoleVariables)
+	{
+		if (Entry.Name.IsEmpty())
+		{
+			continue;
+		}
+
+		if (const uint64 VoteId = AddVote(Entry.Name, Entry.Value, Entry.Priority))
+		{
+			ActiveData.Votes.Emplace(Entry.Name, VoteId);
+		}
+	}
+
+	if (IsRunningDedicatedServer())
+	{
+		return;
+	}
+
+	for (const FGameFeatureScalabilityOverride& Entry : ScalabilityOverrides)
+	{
+		const FString Name = GetScalabilityVariableName(Entry.Group);
+		if (Entry.bOnlyIfLower)
+		{
+			// Compare against the user's own quality, not a value another feature's vote applied
+			const FVariableVotes* VariableVotes = GlobalVotes.Find(Name);
+			const IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Name);
+
+			int32 Quality = INDEX_NONE;
+			if (VariableVotes && !VariableVotes->Votes.IsEmpty())
+			{
+				LexFromString(Quality, *VariableVotes->PriorValue);
+			}
+			else if (Variable)
+			{
+				Quality = Variable->GetInt();
+			}
+
+			if ((Quality != INDEX_NONE) && (Quality <= Entry.Quality))
+			{
+				continue;
+			}
+		}
+
+		if (const uint64 VoteId = AddVote(Name, LexToString(Entry.Quality), Entry.Priority))
+		{
+			ActiveData.Votes.Emplace(Name, VoteId);
+		}
+	}
+}
+
+void UGameFeatureAction_OverrideConsoleVariables::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	for (int32 Index = ActiveData.Votes.Num() - 1; Index >= 0; --Index)
+	{
+		RemoveVote(ActiveData.Votes[Index].Key, ActiveData.Votes[Index].Value);
+	}
+
+	ActiveData.Votes.Empty();
+	ActiveData.bVoted = false;
+}
+
+void UGameFeatureAction_OverrideConsoleVariables::DescribeRuntime(FStringBuilderBase& Out) const
+{
+	for (const TPair<FString, FVariableVotes>& Pair : GlobalVotes)
+	{
+		Out.Appendf(TEXT("%s=%s(%d votes) "), *Pair.Key, *Pair.Value.AppliedValue, Pair.Value.Votes.Num());
+	}
+}
+
+const TCHAR* UGameFeatureAction_OverrideConsoleVariables::GetScalabilityVariableName(EGameFeatureScalabilityGroup Group)
+{
+	switch (Group)
+	{
+	case EGameFeatureScalabilityGroup::ViewDistance:
+		return TEXT("sg.ViewDistanceQuality");
+	case EGameFeatureScalabilityGroup::AntiAliasing:
+		return TEXT("sg.AntiAliasingQuality");
+	case EGameFeatureScalabilityGroup::Shadow:
+		return TEXT("sg.ShadowQuality");
+	case EGameFeatureScalabilityGroup::GlobalIllumination:
+		return TEXT("sg.GlobalIlluminationQuality");
+	case EGameFeatureScalabilityGroup::Reflection:
+		return TEXT("sg.ReflectionQuality");
+	case EGameFeatureScalabilityGroup::PostProcess:
+		return TEXT("sg.PostProcessQuality");
+	case EGameFeatureScalabilityGroup::Texture:
+		return TEXT("sg.TextureQuality");
+	case EGameFeatureScalabilityGroup::Effects:
+		return TEXT("sg.EffectsQuality");
+	case EGameFeatureScalabilityGroup::Foliage:
+		return TEXT("sg.FoliageQuality");
+	case EGameFeatureScalabilityGroup::Shading:
+		return TEXT("sg.ShadingQuality");
+	default:
+		checkNoEntry();
+		return TEXT("");
+	}
+}
+
+uint64 UGameFeatureAction_OverrideConsoleVariables::AddVote(const FString& Name, const FString& Value, int32 Priority)
+{
+	IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Name);
+	if (Variable == nullptr)
+	{
+		UE_LOG(LogGameFeatures, Warning, TEXT("Can't override console variable %s, it doesn't exist."), *Name);
+		return 0;
+	}
+
+	FVariableVotes& VariableVotes = GlobalVotes.FindOrAdd(Name);
+	if (VariableVotes.Votes.IsEmpty())
+	{
+		VariableVotes.PriorValue = Variable->GetString();
+		VariableVotes.PriorSetBy = Variable->GetFlags() & ECVF_SetByMask;
+	}
+
+	const uint64 VoteId = ++LastVoteId;
+	VariableVotes.Votes.Add({ VoteId, Value, Priority });
+	ApplyWinningVote(*Variable, VariableVotes);
+
+	return VoteId;
+}
+
+void UGameFeatureAction_OverrideConsoleVariables::RemoveVote(const FString& Name, uint64 VoteId)
+{
+	FVariableVotes* VariableVotes = GlobalVotes.Find(Name);
+	if (VariableVotes == nullptr)
+	{
+		return;
+	}
+
+	VariableVotes->Votes.RemoveAll([VoteId](const FVote& Vote)
+		{
+			return Vote.Id == VoteId;
+		});
+
+	IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Name);
+	if (Variable && !VariableVotes->Votes.IsEmpty())
+	{
+		ApplyWinningVote(*Variable, *VariableVotes);
+		return;
+	}
+
+	if (Variable)
+	{
+		// Leave the variable alone if something else (e.g. the console) changed it while overridden
+		if (Variable->GetString() == VariableVotes->AppliedValue)
+		{
+			SetWithPriorSetBy(*Variable, VariableVotes->PriorValue, *VariableVotes);
+		}
+		else
+		{
+			UE_LOG(LogGameFeatures, Verbose, TEXT("Not restoring console variable %s, it was changed while overridden."), *Name);
+		}
+	}
+
+	GlobalVotes.Remove(Name);
+}
+
+void UGameFeatureAction_OverrideConsoleVariables::ApplyWinningVote(IConsoleVariable& Variable, FVariableVotes& VariableVotes)
+{
+	const FVote* Winner = nullptr;
+	for (const FVote& Vote : VariableVotes.Votes)
+	{
+		if ((Winner == nullptr) || (Vote.Priority >= Winner->Priority))
+		{
+			Winner = &Vote;
+		}
+	}
+
+	if (Winner && (Variable.GetString() != Winner->Value))
+	{
+		SetWithPriorSetBy(Variable, Winner->Value, VariableVotes);
+	}
+
+	VariableVotes.AppliedValue = Variable.GetString();
+}
+
+void UGameFeatureAction_OverrideConsoleVariables::SetWithPriorSetBy(IConsoleVariable& Variable, const FString& Value, const FVariableVotes& VariableVotes)
+{
+	// Variables set with a higher priority (e.g. from the console) reject the change
+	Variable.Set(*Value, ECVF_SetByCode);
+
+	// Setting raises the priority to Code for good, which would make the variable ignore later changes at a lower priority
+	// (e.g. sg.* from the game user settings). Keep it at the priority it had before the first vote.
+	const uint32 SetBy = Variable.GetFlags() & ECVF_SetByMask;
+	if ((SetBy == ECVF_SetByCode) && (VariableVotes.PriorSetBy < ECVF_SetByCode))
+	{
+		Variable.SetFlags(static_cast<EConsoleVariableFlags>((Variable.GetFlags() & ~ECVF_SetByMask) | VariableVotes.PriorSetBy));
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -9,41 +9,32 @@
 
 TMap<FObjectKey, int32> UGameFeatureAction_SplitscreenConfig::GlobalDisableVotes;
 
-void UGameFeatureAction_SplitscreenConfig::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+void UGameFeatureAction_SplitscreenConfig::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
 {
-	Super::OnGameFeatureDeactivating(Context);
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
 
-	for (int i = LocalDisableVotes.Num() - 1; i >= 0; i--)
+	for (int i = ActiveData.LocalDisableVotes.Num() - 1; i >= 0; i--)
 	{
-		FObjectKey ViewportKey = LocalDisableVotes[i];
+		FObjectKey ViewportKey = ActiveData.LocalDisableVotes[i];
 		UGameViewportClient* GVC = Cast<UGameViewportClient>(ViewportKey.ResolveObjectPtr());
-		const FWorldContext* WorldContext = GEngine->GetWorldContextFromGameViewport(GVC);
 
-		if (GVC && WorldContext)
-		{
-			if (!Context.ShouldApplyToWorldContext(*WorldContext))
-			{
-				continue;
-			}
-		}
-
-		int32& VoteCount = GlobalDisableVotes[ViewportKey];
-		if (VoteCount <= 1)
+		int32* VoteCount = GlobalDisableVotes.Find(ViewportKey);
+		if (!VoteCount || *VoteCount <= 1)
 		{
 			GlobalDisableVotes.Remove(ViewportKey);
 
-			if (GVC && WorldContext)
+			if (GVC)
 			{
 				GVC->SetForceDisableSplitscreen(false);
 			}
 		}
 		else
 		{
-			--VoteCount;
+			--(*VoteCount);
 		}
-
-		LocalDisableVotes.RemoveAt(i);
 	}
+
+	ActiveData.LocalDisableVotes.Empty();
 }
 
 void UGameFeatureAction_SplitscreenConfig::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
@@ -58,7 +49,7 @@ void UGameFeatureAction_SplitscreenConfig::OnAddToWorld(const FWorldContext& Wor
 		if (UGameViewportClient* GVC = GameInstance->GetGameViewportClient())
 		{
 			FObjectKey ViewportKey(GVC);
-			LocalDisableVotes.Add(ViewportKey);
+			FindOrAddContextState<FPerContextData>(ChangeContext).LocalDisableVotes.Add(ViewportKey);
 
 			int32& VoteCount = GlobalDisableVotes.FindOrAdd(ViewportKey);
 			VoteCount++;
@@ -71,4 +62,13 @@ void UGameFeatureAction_SplitscreenConfig::OnAddToWorld(const FWorldContext& Wor
 	}
 }
 
+void UGameFeatureAction_SplitscreenConfig::DescribeRuntime(FStringBuilderBase& Out) const
+{
+	for (const TPair<FObjectKey, int32>& Pair : GlobalDisableVotes)
+	{
+		const UObject* Viewport = Pair.Key.ResolveObjectPtr();
+		Out.Appendf(TEXT("%s=%d "), *GetNameSafe(Viewport), Pair.Value);
+	}
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
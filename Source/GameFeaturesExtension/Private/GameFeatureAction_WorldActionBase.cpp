@@ -3,44 +3,1260 @@
 
 #include "GameFeatureAction_WorldActionBase.h"
 
+#include "GameFeaturesExtensionStats.h"
+#include "GameFeatureActivationTrace.h"
+#include "GameFeatureStreamingManager.h"
+#include "Containers/Ticker.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameplayTagAssetInterface.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Crc.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/DataDrivenPlatformInfoRegistry.h"
+#include "UObject/Class.h"
+#include "UObject/GCObject.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_EDITOR
+#include "GameFeatureActionCostEstimator.h"
+#include "Interfaces/ITargetPlatform.h"
+#include "Misc/DataValidation.h"
+#endif
+
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_WorldActionBase)
 
+namespace UE::GameFeaturesExtension::Conditions
+{
+	// Layout of the compiled condition mask. A world builds the same layout with exactly one bit set per category,
+	// so an action matches when every bit of the world mask is also set in the action's mask.
+	static constexpr uint32 NetModeShift = 0; // Indexed by ENetMode
+	static constexpr uint32 NetModeBits = 0xF;
+	static constexpr uint32 WorldTypeShift = 4;
+	static constexpr uint32 WorldTypeBits = 0x7;
+	static constexpr uint32 PlatformBit = 1u << 7;
+	static constexpr uint32 RuntimeConditionsBit = 1u << 8;
+	static constexpr uint32 CompiledBit = 1u << 31;
+
+	static uint32 MakeWorldMask(const UWorld& World)
+	{
+		uint32 Mask = PlatformBit;
+
+		const ENetMode NetMode = World.GetNetMode();
+		if (NetMode < NM_MAX)
+		{
+			Mask |= (1u << NetMode) << NetModeShift;
+		}
+
+		switch (World.WorldType)
+		{
+		case EWorldType::Game:
+			Mask |= static_cast<uint32>(EGameFeatureActionWorldTypes::Game) << WorldTypeShift;
+			break;
+		case EWorldType::PIE:
+			Mask |= static_cast<uint32>(EGameFeatureActionWorldTypes::PIE) << WorldTypeShift;
+			break;
+		case EWorldType::GamePreview:
+			Mask |= static_cast<uint32>(EGameFeatureActionWorldTypes::GamePreview) << WorldTypeShift;
+			break;
+		default:
+			break;
+		}
+
+		return Mask;
+	}
+}
+
+namespace UE::GameFeaturesExtension::Teardown
+{
+	static float BudgetMs = 0.f;
+	static FAutoConsoleVariableRef CVarBudgetMs(
+		TEXT("GameFeaturesExtension.Teardown.BudgetMs"),
+		BudgetMs,
+		TEXT("Time in milliseconds per frame shared by every world action tearing down deactivated contexts. ")
+		TEXT("Deactivation is then paused until the teardown finished, and what the feature added stays in the world meanwhile. 0 or less (default) tears down synchronously."),
+		ECVF_Default);
+
+	static float RetainSeconds = 0.f;
+	static FAutoConsoleVariableRef CVarRetainSeconds(
+		TEXT("GameFeaturesExtension.Teardown.RetainSeconds"),
+		RetainSeconds,
+		TEXT("Time in seconds what a deactivated context applied is left in place before it is torn down, for world actions supporting incremental teardown. ")
+		TEXT("Activating the same context again within that time (e.g. after editing the feature) only applies what changed since. 0 or less tears down right away."),
+		ECVF_Default);
+}
+
+namespace UE::GameFeaturesExtension::GC
+{
+	static bool bCollectAfterDeactivation = false;
+	static FAutoConsoleVariableRef CVarCollectAfterDeactivation(
+		TEXT("GameFeaturesExtension.GC.CollectAfterDeactivation"),
+		bCollectAfterDeactivation,
+		TEXT("If true, a garbage collection is requested once a world action finished tearing down a context, so everything a feature released is purged together."),
+		ECVF_Default);
+
+	static float PurgeBudgetMs = 0.f;
+	static FAutoConsoleVariableRef CVarPurgeBudgetMs(
+		TEXT("GameFeaturesExtension.GC.PurgeBudgetMs"),
+		PurgeBudgetMs,
+		TEXT("Additional time in milliseconds per frame spent purging objects after a collection requested by a deactivation. 0 leaves purging to the engine."),
+		ECVF_Default);
+
+	static FDelegateHandle PostGarbageCollectHandle;
+	static FTSTicker::FDelegateHandle PurgeTickerHandle;
+
+	static bool TickPurge(float DeltaTime)
+	{
+		if (IsIncrementalPurgePending())
+		{
+			IncrementalPurgeGarbage(/*bUseTimeLimit*/ true, PurgeBudgetMs / 1000.0);
+		}
+
+		if (!IsIncrementalPurgePending())
+		{
+			PurgeTickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	static void HandlePostGarbageCollect()
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+		PostGarbageCollectHandle.Reset();
+
+		if ((PurgeBudgetMs > 0.f) && !PurgeTickerHandle.IsValid() && IsIncrementalPurgePending())
+		{
+			PurgeTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickPurge));
+		}
+	}
+
+	/** Called once a deactivated context released everything it created */
+	static void RequestCollection()
+	{
+		if (!bCollectAfterDeactivation || (GEngine == nullptr))
+		{
+			return;
+		}
+
+		// Only flags the engine, every context finishing before the next collection shares it
+		GEngine->ForceGarbageCollection(/*bFullPurge*/ false);
+
+		if (!PostGarbageCollectHandle.IsValid())
+		{
+			PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&HandlePostGarbageCollect);
+		}
+	}
+}
+
+namespace UE::GameFeaturesExtension::Activity
+{
+	static bool bTrackMemoryDeltas = false;
+	static FAutoConsoleVariableRef CVarTrackMemoryDeltas(
+		TEXT("GameFeaturesExtension.TrackMemoryDeltas"),
+		bTrackMemoryDeltas,
+		TEXT("If true, the memory used by the process is sampled around every world action activation and deactivation and recorded per feature."),
+		ECVF_Default);
+
+	static TMap<FName, FGameFeatureActivityStats> FeatureStats;
+
+	/** World actions with at least one active context */
+	static TSet<UGameFeatureAction_WorldActionBase*> ActiveActions;
+
+	enum class EPhase : uint8
+	{
+		Activation,
+		AddToWorld,
+		Deactivation,
+		Teardown,
+	};
+
+	/** Records a phase for the feature owning the action. Sampling memory isn't free, so it only happens while tracking. */
+	class FScopedRecord
+	{
+	public:
+		FScopedRecord(const UGameFeatureAction_WorldActionBase& InAction, EPhase InPhase)
+			: Action(InAction)
+			, FeatureName(InAction.GetPackage()->GetFName())
+			, Phase(InPhase)
+			, StartTime(FPlatformTime::Seconds())
+			, StartBytes(bTrackMemoryDeltas ? static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) : 0)
+			, bSampled(bTrackMemoryDeltas)
+		{
+		}
+
+		~FScopedRecord()
+		{
+			const double EndTime = FPlatformTime::Seconds();
+			const int64 DeltaBytes = bSampled ? static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - StartBytes : 0;
+
+			FGameFeatureActivityStats& Stats = FeatureStats.FindOrAdd(FeatureName);
+			switch (Phase)
+			{
+			case EPhase::Activation:
+				++Stats.NumActivations;
+				Stats.LastActivationTime = EndTime;
+				Stats.ActivationSeconds += EndTime - StartTime;
+				Stats.ActivationBytes += DeltaBytes;
+				break;
+			case EPhase::AddToWorld:
+				Stats.ActivationSeconds += EndTime - StartTime;
+				Stats.ActivationBytes += DeltaBytes;
+				break;
+			case EPhase::Deactivation:
+				++Stats.NumDeactivations;
+				Stats.DeactivationSeconds += EndTime - StartTime;
+				Stats.DeactivationBytes += DeltaBytes;
+				break;
+			case EPhase::Teardown:
+				Stats.DeactivationSeconds += EndTime - StartTime;
+				Stats.DeactivationBytes += DeltaBytes;
+				break;
+			}
+
+			UGameFeatureAction_WorldActionBase::OnActivityRecorded.Broadcast(Action);
+		}
+
+	private:
+		const UGameFeatureAction_WorldActionBase& Action;
+		FName FeatureName;
+		EPhase Phase;
+		double StartTime;
+		int64 StartBytes;
+		bool bSampled;
+	};
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_WorldActionBase::FRuntimeState
+
+UGameFeatureAction_WorldActionBase::FRuntimeState::FRuntimeState(UGameFeatureAction_WorldActionBase& InOwner)
+	: Owner(InOwner)
+{
+	UE::GameFeaturesExtension::Activity::ActiveActions.Add(&Owner);
+}
+
+UGameFeatureAction_WorldActionBase::FRuntimeState::~FRuntimeState()
+{
+	UE::GameFeaturesExtension::Activity::ActiveActions.Remove(&Owner);
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_WorldActionBase::FTeardownQueue
+
+class UGameFeatureAction_WorldActionBase::FTeardownQueue : public FGCObject
+{
+public:
+	static FTeardownQueue& Get()
+	{
+		static FTeardownQueue Queue;
+		return Queue;
+	}
+
+	void Add(UGameFeatureAction_WorldActionBase& Action, TUniquePtr<FGameFeatureWorldActionContextState>&& State, FSimpleDelegate&& OnComplete)
+	{
+		FJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Action = &Action;
+		Job.State = MoveTemp(State);
+		Job.OnComplete = MoveTemp(OnComplete);
+
+		if (!TickerHandle.IsValid())
+		{
+			TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FTeardownQueue::Tick));
+			WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FTeardownQueue::HandleWorldCleanup);
+		}
+	}
+
+	int32 Num() const
+	{
+		return Jobs.Num();
+	}
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		for (FJob& Job : Jobs)
+		{
+			Collector.AddReferencedObject(Job.Action);
+			Job.State->AddReferencedObjects(Collector);
+		}
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("UGameFeatureAction_WorldActionBase::FTeardownQueue");
+	}
+	//~ End FGCObject Interface
+
+private:
+	struct FJob
+	{
+		TObjectPtr<UGameFeatureAction_WorldActionBase> Action;
+		TUniquePtr<FGameFeatureWorldActionContextState> State;
+		FSimpleDelegate OnComplete;
+	};
+
+	bool Tick(float DeltaTime)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_Deactivate);
+
+		const double EndTime = FPlatformTime::Seconds() + (UE::GameFeaturesExtension::Teardown::BudgetMs / 1000.0);
+
+		// Oldest first, so features finish deactivating in the order they started. Every frame makes progress, however small the budget.
+		do
+		{
+			FJob& Job = Jobs[0];
+
+			bool bIsDone = true;
+			if (Job.Action == nullptr)
+			{
+				// The action was destroyed explicitly (e.g. marked as garbage) while queued, garbage collection cleared the reference
+				UE_LOG(LogGameFeatures, Warning, TEXT("World action destroyed before its queued teardown finished, dropping its context state."));
+			}
+			else
+			{
+				LLM_SCOPE_GAMEFEATURESEXTENSION(Job.Action);
+				TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Teardown"), TEXT("%s %s"), *Job.Action->GetPackage()->GetName(), *Job.Action->GetClass()->GetName());
+				UE::GameFeaturesExtension::Activity::FScopedRecord ActivityRecord(*Job.Action, UE::GameFeaturesExtension::Activity::EPhase::Teardown);
+				bIsDone = Job.Action->ResetContextStateStep(*Job.State);
+			}
+
+			if (bIsDone)
+			{
+				FSimpleDelegate OnComplete = MoveTemp(Job.OnComplete);
+				Jobs.RemoveAt(0);
+
+				UE::GameFeaturesExtension::GC::RequestCollection();
+
+				// Resumes the deactivation, which may deactivate further features and queue more jobs
+				OnComplete.ExecuteIfBound();
+			}
+		}
+		while (!Jobs.IsEmpty() && (FPlatformTime::Seconds() < EndTime));
+
+		if (Jobs.IsEmpty())
+		{
+			FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+			WorldCleanupHandle.Reset();
+			TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	void HandleWorldCleanup(UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+	{
+		for (FJob& Job : Jobs)
+		{
+			if (Job.Action)
+			{
+				Job.Action->OnWorldCleanup(World, *Job.State);
+			}
+		}
+	}
+
+	TArray<FJob> Jobs;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle WorldCleanupHandle;
+};
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_WorldActionBase::FRetainedContexts
+
+class UGameFeatureAction_WorldActionBase::FRetainedContexts : public FGCObject
+{
+public:
+	static FRetainedContexts& Get()
+	{
+		static FRetainedContexts Retained;
+		return Retained;
+	}
+
+	void Add(UGameFeatureAction_WorldActionBase& Action, const FGameFeatureStateChangeContext& ChangeContext, TUniquePtr<FGameFeatureWorldActionContextState>&& State)
+	{
+		FRetained& Retained = Contexts.AddDefaulted_GetRef();
+		Retained.Action = &Action;
+		Retained.ChangeContext = ChangeContext;
+		Retained.State = MoveTemp(State);
+		Retained.ExpireTime = FPlatformTime::Seconds() + UE::GameFeaturesExtension::Teardown::RetainSeconds;
+
+		if (!TickerHandle.IsValid())
+		{
+			TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FRetainedContexts::Tick));
+			WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FRetainedContexts::HandleWorldCleanup);
+		}
+	}
+
+	/** Returns the state retained for the given context of Action, if it is still there */
+	TUniquePtr<FGameFeatureWorldActionContextState> Reclaim(const UGameFeatureAction_WorldActionBase& Action, const FGameFeatureStateChangeContext& ChangeContext)
+	{
+		const int32 Index = Contexts.IndexOfByPredicate([&Action, &ChangeContext](const FRetained& Retained)
+			{
+				return (Retained.Action == &Action) && (Retained.ChangeContext == ChangeContext);
+			});
+
+		if (Index == INDEX_NONE)
+		{
+			return nullptr;
+		}
+
+		TUniquePtr<FGameFeatureWorldActionContextState> State = MoveTemp(Contexts[Index].State);
+		Contexts.RemoveAt(Index);
+		return State;
+	}
+
+	int32 Num() const
+	{
+		return Contexts.Num();
+	}
+
+	/** Tears down every context retained for Action right away */
+	void Flush(const UGameFeatureAction_WorldActionBase& Action)
+	{
+		TearDown([&Action](const FRetained& Retained)
+			{
+				return Retained.Action == &Action;
+			});
+	}
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		for (FRetained& Retained : Contexts)
+		{
+			Collector.AddReferencedObject(Retained.Action);
+			Retained.State->AddReferencedObjects(Collector);
+		}
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("UGameFeatureAction_WorldActionBase::FRetainedContexts");
+	}
+	//~ End FGCObject Interface
+
+private:
+	struct FRetained
+	{
+		TObjectPtr<UGameFeatureAction_WorldActionBase> Action;
+		FGameFeatureStateChangeContext ChangeContext;
+		TUniquePtr<FGameFeatureWorldActionContextState> State;
+		double ExpireTime = 0.0;
+	};
+
+	template <typename PredicateType>
+	void TearDown(PredicateType&& Predicate)
+	{
+		// Moved out first, resetting may retain or reclaim other contexts
+		TArray<FRetained> Expired;
+		for (int32 Index = Contexts.Num() - 1; Index >= 0; --Index)
+		{
+			if (Predicate(Contexts[Index]))
+			{
+				Expired.Add(MoveTemp(Contexts[Index]));
+				Contexts.RemoveAt(Index);
+			}
+		}
+
+		for (FRetained& Retained : Expired)
+		{
+			// Cleared by garbage collection if the action was destroyed explicitly, nothing can undo its state anymore
+			if (Retained.Action)
+			{
+				Retained.Action->ResetContextState(*Retained.State);
+			}
+		}
+
+		if (!Expired.IsEmpty())
+		{
+			UE::GameFeaturesExtension::GC::RequestCollection();
+		}
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		const double Now = FPlatformTime::Seconds();
+		TearDown([Now](const FRetained& Retained)
+			{
+				return (Retained.ExpireTime <= Now) || (Retained.Action == nullptr);
+			});
+
+		if (Contexts.IsEmpty())
+		{
+			FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+			WorldCleanupHandle.Reset();
+			TickerHandle.Reset();
+			return false;
+		}
+
+		return true;
+	}
+
+	void HandleWorldCleanup(UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+	{
+		for (FRetained& Retained : Contexts)
+		{
+			if (Retained.Action)
+			{
+				Retained.Action->OnWorldCleanup(World, *Retained.State);
+			}
+		}
+	}
+
+	TArray<FRetained> Contexts;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle WorldCleanupHandle;
+};
+
+//////////////////////////////////////////////////////////////////////
+// FGameFeatureActionConditions
+
+bool FGameFeatureActionConditions::AllowsPlatform(FName PlatformName, FName PlatformGroupName) const
+{
+	return Platforms.IsEmpty() ||
+		Platforms.Contains(PlatformName) ||
+		(!PlatformGroupName.IsNone() && Platforms.Contains(PlatformGroupName));
+}
+
+uint32 FGameFeatureActionConditions::CompileMask() const
+{
+	using namespace UE::GameFeaturesExtension::Conditions;
+
+	const uint32 NetModeMask = NetModes != 0 ? (static_cast<uint32>(NetModes) & NetModeBits) : NetModeBits;
+	const uint32 WorldTypeMask = WorldTypes != 0 ? (static_cast<uint32>(WorldTypes) & WorldTypeBits) : WorldTypeBits;
+
+	return (NetModeMask << NetModeShift) |
+		(WorldTypeMask << WorldTypeShift) |
+		(HasRuntimeConditions() ? RuntimeConditionsBit : 0);
+}
+
+bool FGameFeatureActionConditions::HasRuntimeConditions() const
+{
+	return !GameModeClass.IsNull() || !TagQuery.IsEmpty();
+}
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_WorldActionBase
+
+void UGameFeatureAction_WorldActionBase::OnGameFeatureLoading()
+{
+	SCOPED_GAMEFEATURE_ACTIVATION_TRACE(FGameFeatureActivationTrace::EEventType::Load, *this);
+
+	Super::OnGameFeatureLoading();
+
+	if (PrewarmHandle.IsValid() || !IsRelevantForThisProcess() || !UAssetManager::IsInitialized())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> Assets;
+	GatherPrewarmAssets(Assets);
+	Assets.RemoveAll([](const FSoftObjectPath& Asset)
+		{
+			return Asset.IsNull();
+		});
+
+	if (Assets.IsEmpty())
+	{
+		return;
+	}
+
+	UE_LOG(LogGameFeatures, Verbose, TEXT("[%s]: Prewarming %d assets"), *GetPathName(), Assets.Num());
+
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Prewarm"), TEXT("%s %s (%d assets)"), *GetPackage()->GetName(), *GetClass()->GetName(), Assets.Num());
+
+	PrewarmHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(MoveTemp(Assets), EGameFeatureStreamingPriority::Visual,
+		FStreamableDelegate(), FString::Printf(TEXT("Prewarm %s"), *GetName()));
+}
+
+void UGameFeatureAction_WorldActionBase::OnGameFeatureUnloading()
+{
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Unload"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+	SCOPED_GAMEFEATURE_ACTIVATION_TRACE(FGameFeatureActivationTrace::EEventType::Unload, *this);
+
+	Super::OnGameFeatureUnloading();
+
+	// Nothing can reactivate a context of an unloaded feature
+	FRetainedContexts::Get().Flush(*this);
+
+	if (PrewarmHandle.IsValid())
+	{
+		// Cancels the loads still in flight and releases the ones that completed
+		PrewarmHandle->CancelHandle();
+		PrewarmHandle.Reset();
+	}
+}
+
 void UGameFeatureAction_WorldActionBase::OnGameFeatureActivating(FGameFeatureActivatingContext& Context)
 {
+	SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_Activate);
+
+	if (!IsRelevantForThisProcess())
+	{
+		return;
+	}
+
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Activate"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+	UE::GameFeaturesExtension::Activity::FScopedRecord ActivityRecord(*this, UE::GameFeaturesExtension::Activity::EPhase::Activation);
+	SCOPED_GAMEFEATURE_ACTIVATION_TRACE(FGameFeatureActivationTrace::EEventType::Activate, *this);
+
+	if (!ensureMsgf(IndexOfContextEntry(Context) == INDEX_NONE, TEXT("%s was activated twice for the same context"), *GetPathName()))
+	{
+		return;
+	}
+
+	FContextEntry& Entry = FindOrAddContextEntry(Context);
+	Entry.ActivationTime = FPlatformTime::Seconds();
+
 	// Bind to the game instance start delegate
-	GameInstanceStartHandles.FindOrAdd(Context) = FWorldDelegates::OnStartGameInstance.AddUObject
+	Entry.GameInstanceStartHandle = FWorldDelegates::OnStartGameInstance.AddUObject
 	(
 		this,
 		&ThisClass::HandleGameInstanceStart,
 		FGameFeatureStateChangeContext(Context)
 	);
 
-	// Add to any worlds that are already loaded
-	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	// Deactivated recently enough that what it applied is still in place, only apply what changed since
+	if (TUniquePtr<FGameFeatureWorldActionContextState> RetainedState = FRetainedContexts::Get().Reclaim(*this, Context))
 	{
-		if (Context.ShouldApplyToWorldContext(WorldContext))
+		Entry.State = MoveTemp(RetainedState);
+		ReconcileContext(Context);
+		return;
+	}
+
+	// Add to any worlds that are already loaded
+	ForEachRelevantWorldContext(Context, [this, &Context](const FWorldContext& WorldContext)
 		{
+			SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_AddToWorld);
+			TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction AddToWorld"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
 			OnAddToWorld(WorldContext, Context);
+		});
+}
+
+void UGameFeatureAction_WorldActionBase::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_Deactivate);
+
+	if (!IsRelevantForThisProcess())
+	{
+		return;
+	}
+
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Deactivate"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+	UE::GameFeaturesExtension::Activity::FScopedRecord ActivityRecord(*this, UE::GameFeaturesExtension::Activity::EPhase::Deactivation);
+	SCOPED_GAMEFEATURE_ACTIVATION_TRACE(FGameFeatureActivationTrace::EEventType::Deactivate, *this);
+
+	const int32 EntryIndex = IndexOfContextEntry(Context);
+	if (!ensure(EntryIndex != INDEX_NONE))
+	{
+		return;
+	}
+
+	if (SupportsIncrementalTeardown() && (UE::GameFeaturesExtension::Teardown::RetainSeconds > 0.f))
+	{
+		// Left in place for a while, in case the context is activated again (e.g. after editing the feature)
+		if (TUniquePtr<FGameFeatureWorldActionContextState> State = DetachContextEntry(Context))
+		{
+			FRetainedContexts::Get().Add(*this, Context, MoveTemp(State));
+		}
+		return;
+	}
+
+	if (SupportsIncrementalTeardown() && (UE::GameFeaturesExtension::Teardown::BudgetMs > 0.f))
+	{
+		// Spread the teardown over the next frames, the feature finishes deactivating once it is done
+		if (TUniquePtr<FGameFeatureWorldActionContextState> State = DetachContextEntry(Context))
+		{
+			FTeardownQueue::Get().Add(*this, MoveTemp(State), Context.PauseDeactivationUntilComplete(FString::Printf(TEXT("%s teardown"), *GetName())));
 		}
+		return;
 	}
+
+	RemoveContextEntry(Context);
+	UE::GameFeaturesExtension::GC::RequestCollection();
 }
 
-void UGameFeatureAction_WorldActionBase::OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context)
+bool UGameFeatureAction_WorldActionBase::NeedsLoadForClient() const
 {
-	FDelegateHandle* Handle = GameInstanceStartHandles.Find(Context);
-	if (ensure(Handle))
+	// Client targets run standalone, listen server and client worlds
+	const int32 ClientNetModes = static_cast<int32>(EGameFeatureActionNetModes::Standalone | EGameFeatureActionNetModes::ListenServer | EGameFeatureActionNetModes::Client);
+	if ((Conditions.NetModes != 0) && ((Conditions.NetModes & ClientNetModes) == 0))
 	{
-		FWorldDelegates::OnStartGameInstance.Remove(*Handle);
+		return false;
 	}
+
+	return (GetNetExecution() != EGameFeatureActionNetExecution::ServerOnly) && Super::NeedsLoadForClient();
 }
 
-void UGameFeatureAction_WorldActionBase::HandleGameInstanceStart(UGameInstance* GameInstance, FGameFeatureStateChangeContext ChangeContext)
+bool UGameFeatureAction_WorldActionBase::NeedsLoadForServer() const
 {
-	if (const FWorldContext* WorldContext = GameInstance->GetWorldContext())
+	if ((Conditions.NetModes != 0) && ((Conditions.NetModes & static_cast<int32>(EGameFeatureActionNetModes::DedicatedServer)) == 0))
 	{
-		if (ChangeContext.ShouldApplyToWorldContext(*WorldContext))
-		{
-			OnAddToWorld(*WorldContext, ChangeContext);
-		}
+		return false;
 	}
+
+	return (GetNetExecution() != EGameFeatureActionNetExecution::ClientOnly) && Super::NeedsLoadForServer();
+}
+
+bool UGameFeatureAction_WorldActionBase::CanBeInCluster() const
+{
+	// Objects created while active are only reported through AddReferencedObjects, which clusters don't call
+	return false;
+}
+
+void UGameFeatureAction_WorldActionBase::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Loaded objects are compiled in PostLoad, once their properties are known
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_NeedLoad))
+	{
+		CompileConditions(FName(FPlatformProperties::IniPlatformName()));
+	}
+}
+
+void UGameFeatureAction_WorldActionBase::PostLoad()
+{
+	Super::PostLoad();
+
+	// Cooked data was compiled for its platform when it was saved
+	const bool bIsCompiled = (CompiledConditionMask & UE::GameFeaturesExtension::Conditions::CompiledBit) != 0;
+	if (!FPlatformProperties::RequiresCookedData() || !bIsCompiled)
+	{
+		CompileConditions(FName(FPlatformProperties::IniPlatformName()));
+	}
+}
+
+void UGameFeatureAction_WorldActionBase::Serialize(FArchive& Ar)
+{
+#if WITH_EDITOR
+	// Only the cooked copy carries the target platform's mask, the object in memory stays compiled for the host
+	if (Ar.IsSaving() && Ar.IsCooking() && Ar.CookingTarget())
+	{
+		const uint32 HostConditionMask = CompiledConditionMask;
+		CompileConditions(FName(*Ar.CookingTarget()->IniPlatformName()));
+		Super::Serialize(Ar);
+		CompiledConditionMask = HostConditionMask;
+		return;
+	}
+#endif
+
+	Super::Serialize(Ar);
+}
+
+#if WITH_EDITOR
+EDataValidationResult UGameFeatureAction_WorldActionBase::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = Super::IsDataValid(Context);
+
+	// Only the action budgets, the feature budgets are checked by action sets and the cost commandlet
+	if (!FGameFeatureActionCostEstimator::CheckActionBudgets(FGameFeatureActionCostEstimator::EstimateAction(*this), Context))
+	{
+		Result = CombineDataValidationResults(Result, FGameFeatureActionCostEstimator::GetOverBudgetResult());
+	}
+
+	return Result;
+}
+
+bool UGameFeatureAction_WorldActionBase::NeedsLoadForTargetPlatform(const ITargetPlatform* TargetPlatform) const
+{
+	if (TargetPlatform)
+	{
+		const FName PlatformName(*TargetPlatform->IniPlatformName());
+		if (!Conditions.AllowsPlatform(PlatformName, FDataDrivenPlatformInfoRegistry::GetPlatformInfo(PlatformName).PlatformGroupName))
+		{
+			return false;
+		}
+	}
+
+	return Super::NeedsLoadForTargetPlatform(TargetPlatform);
+}
+#endif
+
+void UGameFeatureAction_WorldActionBase::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+
+	ThisClass* This = CastChecked<ThisClass>(InThis);
+	This->ForEachContextState<FGameFeatureWorldActionContextState>([&Collector](FGameFeatureWorldActionContextState& State)
+		{
+			State.AddReferencedObjects(Collector);
+		});
+}
+
+#if WITH_EDITOR
+void UGameFeatureAction_WorldActionBase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	CompileConditions(FName(FPlatformProperties::IniPlatformName()));
+
+	// Apply edits made while the feature is active (e.g. during PIE) right away, without cycling the whole feature
+	if (Runtime.IsValid() && (PropertyChangedEvent.ChangeType != EPropertyChangeType::Interactive))
+	{
+		ReconcileActiveContexts();
+	}
+}
+#endif
+
+EGameFeatureActionNetExecution UGameFeatureAction_WorldActionBase::GetNetExecution() const
+{
+	return EGameFeatureActionNetExecution::Any;
+}
+
+int32 UGameFeatureAction_WorldActionBase::GetNumContextEntries() const
+{
+	return Runtime.IsValid() ? Runtime->ContextEntries.Num() : 0;
+}
+
+int32 UGameFeatureAction_WorldActionBase::GetNumDeferredContexts()
+{
+	return FTeardownQueue::Get().Num() + FRetainedContexts::Get().Num();
+}
+
+FOnGameFeatureActivityRecorded UGameFeatureAction_WorldActionBase::OnActivityRecorded;
+
+const TMap<FName, FGameFeatureActivityStats>& UGameFeatureAction_WorldActionBase::GetFeatureActivityStats()
+{
+	return UE::GameFeaturesExtension::Activity::FeatureStats;
+}
+
+void UGameFeatureAction_WorldActionBase::ResetFeatureActivityStats()
+{
+	UE::GameFeaturesExtension::Activity::FeatureStats.Empty();
+}
+
+void UGameFeatureAction_WorldActionBase::ForEachActiveAction(TFunctionRef<void(const UGameFeatureAction_WorldActionBase&)> Func)
+{
+	for (const UGameFeatureAction_WorldActionBase* Action : UE::GameFeaturesExtension::Activity::ActiveActions)
+	{
+		Func(*Action);
+	}
+}
+
+void UGameFeatureAction_WorldActionBase::DumpActiveContexts(FOutputDevice& Ar) const
+{
+	if (!Runtime.IsValid())
+	{
+		return;
+	}
+
+	TStringBuilder<256> RuntimeSummary;
+	DescribeRuntime(RuntimeSummary);
+	if (RuntimeSummary.Len() > 0)
+	{
+		Ar.Logf(TEXT("    Runtime: %s"), *RuntimeSummary);
+	}
+
+	const double Now = FPlatformTime::Seconds();
+
+	int32 EntryIndex = 0;
+	for (const FContextEntry& Entry : Runtime->ContextEntries)
+	{
+		TStringBuilder<256> Summary;
+		SIZE_T StateBytes = 0;
+		if (Entry.State.IsValid())
+		{
+			Entry.State->Describe(Summary);
+			StateBytes = Entry.State->GetAllocatedSize();
+		}
+
+		Ar.Logf(TEXT("    Context %d: Active=%.1fs  StateBytes=%llu  %s"),
+			EntryIndex, Now - Entry.ActivationTime, static_cast<uint64>(StateBytes), *Summary);
+
+		++EntryIndex;
+	}
+}
+
+SIZE_T UGameFeatureAction_WorldActionBase::GetRuntimeAllocatedSize() const
+{
+	if (!Runtime.IsValid())
+	{
+		return 0;
+	}
+
+	SIZE_T Size = sizeof(FRuntimeState) + Runtime->ContextEntries.GetAllocatedSize();
+	for (const FContextEntry& Entry : Runtime->ContextEntries)
+	{
+		if (Entry.State.IsValid())
+		{
+			Size += Entry.State->GetAllocatedSize();
+		}
+	}
+	return Size;
+}
+
+double UGameFeatureAction_WorldActionBase::GetLastActivationTime() const
+{
+	double LastActivationTime = 0.0;
+	if (Runtime.IsValid())
+	{
+		for (const FContextEntry& Entry : Runtime->ContextEntries)
+		{
+			LastActivationTime = FMath::Max(LastActivationTime, Entry.ActivationTime);
+		}
+	}
+	return LastActivationTime;
+}
+
+void UGameFeatureAction_WorldActionBase::ReconcileActiveContexts()
+{
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction Reconcile"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+
+	if (!Runtime.IsValid())
+	{
+		return;
+	}
+
+	// Copied, reconciling may add or drop entries
+	TArray<FGameFeatureStateChangeContext> ActiveContexts;
+	ActiveContexts.Reserve(Runtime->ContextEntries.Num());
+	for (const FContextEntry& Entry : Runtime->ContextEntries)
+	{
+		ActiveContexts.Add(Entry.ChangeContext);
+	}
+
+	for (const FGameFeatureStateChangeContext& ChangeContext : ActiveContexts)
+	{
+		if (IndexOfContextEntry(ChangeContext) != INDEX_NONE)
+		{
+			ReconcileContext(ChangeContext);
+		}
+	}
+}
+
+bool UGameFeatureAction_WorldActionBase::IsRelevantForThisProcess() const
+{
+	if ((CompiledConditionMask & UE::GameFeaturesExtension::Conditions::PlatformBit) == 0)
+	{
+		return false;
+	}
+
+	const EGameFeatureActionNetExecution NetExecution = GetNetExecution();
+
+#if UE_SERVER
+	return NetExecution != EGameFeatureActionNetExecution::ClientOnly;
+#else
+	if (IsRunningDedicatedServer())
+	{
+		return NetExecution != EGameFeatureActionNetExecution::ClientOnly;
+	}
+
+	if (IsRunningClientOnly())
+	{
+		return NetExecution != EGameFeatureActionNetExecution::ServerOnly;
+	}
+
+	return true;
+#endif
+}
+
+bool UGameFeatureAction_WorldActionBase::IsRelevantForWorld(const FWorldContext& WorldContext) const
+{
+	const UWorld* World = WorldContext.World();
+	if (World == nullptr)
+	{
+		// Let the subclass decide what to do without a world
+		return true;
+	}
+
+	switch (GetNetExecution())
+	{
+	case EGameFeatureActionNetExecution::ClientOnly:
+		if (World->GetNetMode() == NM_DedicatedServer)
+		{
+			return false;
+		}
+		break;
+	case EGameFeatureActionNetExecution::ServerOnly:
+		if (World->GetNetMode() == NM_Client)
+		{
+			return false;
+		}
+		break;
+	default:
+		break;
+	}
+
+	const uint32 WorldMask = UE::GameFeaturesExtension::Conditions::MakeWorldMask(*World);
+	if ((CompiledConditionMask & WorldMask) != WorldMask)
+	{
+		return false;
+	}
+
+	// Game mode and tag conditions need the world itself, only pay for them when they are set
+	if ((CompiledConditionMask & UE::GameFeaturesExtension::Conditions::RuntimeConditionsBit) != 0)
+	{
+		return PassesRuntimeConditions(*World);
+	}
+
+	return true;
+}
+
+void UGameFeatureAction_WorldActionBase::HandleGameInstanceStart(UGameInstance* GameInstance, FGameFeatureStateChangeContext ChangeContext)
+{
+	if (const FWorldContext* WorldContext = GameInstance->GetWorldContext())
+	{
+		if (ChangeContext.ShouldApplyToWorldContext(*WorldContext) && IsRelevantForWorld(*WorldContext))
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_AddToWorld);
+			LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+			TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction AddToWorld"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+			UE::GameFeaturesExtension::Activity::FScopedRecord ActivityRecord(*this, UE::GameFeaturesExtension::Activity::EPhase::AddToWorld);
+			SCOPED_GAMEFEATURE_ACTIVATION_TRACE(NullOpt, *this);
+			OnAddToWorld(*WorldContext, ChangeContext);
+		}
+	}
+}
+
+void UGameFeatureAction_WorldActionBase::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+}
+
+void UGameFeatureAction_WorldActionBase::ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	if (FGameFeatureWorldActionContextState* State = FindContextState<FGameFeatureWorldActionContextState>(ChangeContext))
+	{
+		ResetContextState(*State);
+	}
+
+	ForEachRelevantWorldContext(ChangeContext, [this, &ChangeContext](const FWorldContext& WorldContext)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_GameFeaturesExtension_AddToWorld);
+			TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction AddToWorld"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+			OnAddToWorld(WorldContext, ChangeContext);
+		});
+}
+
+void UGameFeatureAction_WorldActionBase::ForEachRelevantWorldContext(const FGameFeatureStateChangeContext& ChangeContext, TFunctionRef<void(const FWorldContext&)> Func) const
+{
+	for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+	{
+		if (ChangeContext.ShouldApplyToWorldContext(WorldContext) && IsRelevantForWorld(WorldContext))
+		{
+			Func(WorldContext);
+		}
+	}
+}
+
+uint32 UGameFeatureAction_WorldActionBase::HashEntry(const UScriptStruct* Struct, const void* Entry)
+{
+	check(Struct && Entry);
+
+	// Only used when reconciling, so going through the text export keeps this working for any entry type
+	FString EntryText;
+	Struct->ExportText(EntryText, Entry, nullptr, nullptr, PPF_None, nullptr);
+	return FCrc::StrCrc32(*EntryText);
+}
+
+void UGameFeatureAction_WorldActionBase::DiffEntryHashes(TConstArrayView<uint32> AppliedHashes, TConstArrayView<uint32> DesiredHashes, TArray<int32>& OutDesiredToApply, TArray<int32>& OutAppliedToUndo)
+{
+	TMultiMap<uint32, int32> UnclaimedApplied;
+	for (int32 AppliedIndex = 0; AppliedIndex < AppliedHashes.Num(); ++AppliedIndex)
+	{
+		UnclaimedApplied.Add(AppliedHashes[AppliedIndex], AppliedIndex);
+	}
+
+	for (int32 DesiredIndex = 0; DesiredIndex < DesiredHashes.Num(); ++DesiredIndex)
+	{
+		if (const int32* AppliedIndex = UnclaimedApplied.Find(DesiredHashes[DesiredIndex]))
+		{
+			const int32 ClaimedIndex = *AppliedIndex;
+			UnclaimedApplied.Remove(DesiredHashes[DesiredIndex], ClaimedIndex);
+		}
+		else
+		{
+			OutDesiredToApply.Add(DesiredIndex);
+		}
+	}
+
+	UnclaimedApplied.GenerateValueArray(OutAppliedToUndo);
+	OutAppliedToUndo.Sort(TGreater<int32>());
+}
+
+void UGameFeatureAction_WorldActionBase::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+}
+
+void UGameFeatureAction_WorldActionBase::DescribeRuntime(FStringBuilderBase& Out) const
+{
+}
+
+bool UGameFeatureAction_WorldActionBase::SupportsIncrementalTeardown() const
+{
+	return false;
+}
+
+bool UGameFeatureAction_WorldActionBase::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
+{
+	ResetContextState(ContextState);
+	return true;
+}
+
+void UGameFeatureAction_WorldActionBase::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+}
+
+UGameFeatureAction_WorldActionBase::FContextEntry& UGameFeatureAction_WorldActionBase::FindOrAddContextEntry(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	const int32 ExistingIndex = IndexOfContextEntry(ChangeContext);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return Runtime->ContextEntries[ExistingIndex];
+	}
+
+	if (!Runtime.IsValid())
+	{
+		Runtime = MakeUnique<FRuntimeState>(*this);
+		Runtime->WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &ThisClass::HandleWorldCleanup);
+	}
+
+	INC_DWORD_STAT(STAT_GameFeaturesExtension_LiveContextEntries);
+
+	FContextEntry& NewEntry = Runtime->ContextEntries.AddDefaulted_GetRef();
+	NewEntry.ChangeContext = ChangeContext;
+	return NewEntry;
+}
+
+int32 UGameFeatureAction_WorldActionBase::IndexOfContextEntry(const FGameFeatureStateChangeContext& ChangeContext) const
+{
+	if (!Runtime.IsValid())
+	{
+		return INDEX_NONE;
+	}
+
+	return Runtime->ContextEntries.IndexOfByPredicate([&ChangeContext](const FContextEntry& Entry)
+		{
+			return Entry.ChangeContext == ChangeContext;
+		});
+}
+
+void UGameFeatureAction_WorldActionBase::RemoveContextEntry(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	const int32 EntryIndex = IndexOfContextEntry(ChangeContext);
+	if (!ensure(EntryIndex != INDEX_NONE))
+	{
+		return;
+	}
+
+	FWorldDelegates::OnStartGameInstance.Remove(Runtime->ContextEntries[EntryIndex].GameInstanceStartHandle);
+	Runtime->ContextEntries[EntryIndex].GameInstanceStartHandle.Reset();
+
+	// Reset while the state is still registered, teardown callbacks (e.g. extension removed events) look it up by context
+	if (FGameFeatureWorldActionContextState* State = Runtime->ContextEntries[EntryIndex].State.Get())
+	{
+		ResetContextState(*State);
+	}
+
+	DetachContextEntry(ChangeContext);
+}
+
+TUniquePtr<FGameFeatureWorldActionContextState> UGameFeatureAction_WorldActionBase::DetachContextEntry(const FGameFeatureStateChangeContext& ChangeContext)
+{
+	const int32 EntryIndex = IndexOfContextEntry(ChangeContext);
+	if (EntryIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FContextEntry& Entry = Runtime->ContextEntries[EntryIndex];
+	FWorldDelegates::OnStartGameInstance.Remove(Entry.GameInstanceStartHandle);
+	TUniquePtr<FGameFeatureWorldActionContextState> State = MoveTemp(Entry.State);
+
+	Runtime->ContextEntries.RemoveAtSwap(EntryIndex);
+	DEC_DWORD_STAT(STAT_GameFeaturesExtension_LiveContextEntries);
+
+	if (Runtime->ContextEntries.IsEmpty())
+	{
+		// Release the runtime state entirely, inactive actions shouldn't hold on to any memory
+		FWorldDelegates::OnWorldCleanup.Remove(Runtime->WorldCleanupHandle);
+		Runtime.Reset();
+	}
+
+	return State;
+}
+
+void UGameFeatureAction_WorldActionBase::CompileConditions(FName PlatformName)
+{
+	using namespace UE::GameFeaturesExtension::Conditions;
+
+	uint32 Mask = Conditions.CompileMask() | CompiledBit;
+	if (Conditions.AllowsPlatform(PlatformName, FDataDrivenPlatformInfoRegistry::GetPlatformInfo(PlatformName).PlatformGroupName))
+	{
+		Mask |= PlatformBit;
+	}
+
+	CompiledConditionMask = Mask;
+}
+
+bool UGameFeatureAction_WorldActionBase::PassesRuntimeConditions(const UWorld& World) const
+{
+	if (!Conditions.GameModeClass.IsNull())
+	{
+		// Clients only know the game mode through the game state, before that the world settings are the best guess
+		const UClass* WorldGameModeClass = nullptr;
+		if (const AGameModeBase* GameMode = World.GetAuthGameMode())
+		{
+			WorldGameModeClass = GameMode->GetClass();
+		}
+		else if (const AGameStateBase* GameState = World.GetGameState())
+		{
+			WorldGameModeClass = GameState->GameModeClass;
+		}
+		else if (const AWorldSettings* WorldSettings = World.GetWorldSettings())
+		{
+			WorldGameModeClass = WorldSettings->DefaultGameMode;
+		}
+
+		const UClass* RequiredGameModeClass = Conditions.GameModeClass.Get();
+		if (!WorldGameModeClass || !RequiredGameModeClass || !WorldGameModeClass->IsChildOf(RequiredGameModeClass))
+		{
+			return false;
+		}
+	}
+
+	if (!Conditions.TagQuery.IsEmpty())
+	{
+		FGameplayTagContainer WorldTags;
+		if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(World.GetGameState()))
+		{
+			TagInterface->GetOwnedGameplayTags(WorldTags);
+		}
+
+		if (const IGameplayTagAssetInterface* TagInterface = Cast<IGameplayTagAssetInterface>(World.GetWorldSettings()))
+		{
+			FGameplayTagContainer SettingsTags;
+			TagInterface->GetOwnedGameplayTags(SettingsTags);
+			WorldTags.AppendTags(SettingsTags);
+		}
+
+		if (!Conditions.TagQuery.Matches(WorldTags))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void UGameFeatureAction_WorldActionBase::HandleWorldCleanup(UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+{
+	ForEachContextState<FGameFeatureWorldActionContextState>([this, World](FGameFeatureWorldActionContextState& State)
+		{
+			OnWorldCleanup(World, State);
+		});
 }
@@ -0,0 +1,529 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureActivationTrace.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Components/GameFrameworkComponentManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFeatureAction.h"
+#include "GameFeatureDevelopmentScopes.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDevice.h"
+#include "Misc/Paths.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+bool FGameFeatureActivationTrace::bRecording = false;
+int32 FGameFeatureActivationTrace::ActionDepth = 0;
+
+namespace UE::GameFeaturesExtension::ActivationTrace
+{
+	using EEventType = FGameFeatureActivationTrace::EEventType;
+
+	static const TCHAR* const FileHeader = TEXT("# GameFeaturesExtension activation trace v1: Time\tType\tSubject\tDetail\tInstance\tDurationMs");
+
+	static const TCHAR* const EventTypeNames[] =
+	{
+		TEXT("Load"),
+		TEXT("Unload"),
+		TEXT("Activate"),
+		TEXT("Deactivate"),
+		TEXT("GameInstanceStart"),
+		TEXT("LocalPlayerAdded"),
+		TEXT("Extension"),
+	};
+
+	struct FEvent
+	{
+		/** Seconds since recording started */
+		double Time = 0.0;
+
+		EEventType Type = EEventType::Load;
+
+		/** Path of the action, or class of the game instance, local player or extension receiver */
+		FString Subject;
+
+		/** Extension event name or controller id */
+		FString Detail;
+
+		/** Name of the extension receiver, so events sent to the same actor are replayed on the same actor */
+		FString Instance;
+
+		/** Time spent in the action callback while recording */
+		double DurationMs = 0.0;
+	};
+
+	struct FRecording
+	{
+		FString Filename;
+		double StartTime = 0.0;
+		TArray<FEvent> Events;
+
+		FDelegateHandle StartGameInstanceHandle;
+		TMap<TWeakObjectPtr<UGameInstance>, FDelegateHandle> LocalPlayerAddedHandles;
+
+		/** Extension events recorded during FrameNumber, several actions usually receive the same event */
+		uint64 FrameNumber = 0;
+		TSet<TPair<FObjectKey, FName>> FrameExtensionEvents;
+	};
+
+	static TUniquePtr<FRecording> Recording;
+
+	static FEvent& AddEvent(EEventType Type)
+	{
+		FEvent& Event = Recording->Events.AddDefaulted_GetRef();
+		Event.Time = FPlatformTime::Seconds() - Recording->StartTime;
+		Event.Type = Type;
+		return Event;
+	}
+
+	static void HandleLocalPlayerAdded(ULocalPlayer* LocalPlayer)
+	{
+		if (Recording.IsValid() && LocalPlayer)
+		{
+			FEvent& Event = AddEvent(EEventType::LocalPlayerAdded);
+			Event.Subject = LocalPlayer->GetClass()->GetPathName();
+			Event.Detail = LexToString(LocalPlayer->GetControllerId());
+		}
+	}
+
+	static void BindGameInstance(UGameInstance* GameInstance)
+	{
+		if (GameInstance && !Recording->LocalPlayerAddedHandles.Contains(GameInstance))
+		{
+			Recording->LocalPlayerAddedHandles.Add(GameInstance, GameInstance->OnLocalPlayerAddedEvent.AddStatic(&HandleLocalPlayerAdded));
+		}
+	}
+
+	static void HandleStartGameInstance(UGameInstance* GameInstance)
+	{
+		if (Recording.IsValid() && GameInstance)
+		{
+			FEvent& Event = AddEvent(EEventType::GameInstanceStart);
+			Event.Subject = GameInstance->GetClass()->GetPathName();
+			Event.Detail = GameInstance->GetWorld() ? GameInstance->GetWorld()->GetMapName() : FString();
+
+			BindGameInstance(GameInstance);
+		}
+	}
+
+	static FString ResolveFilename(const FString& Filename)
+	{
+		if (Filename.IsEmpty())
+		{
+			return FPaths::ProjectSavedDir() / TEXT("Traces") / FString::Printf(TEXT("GameFeatures-%s.gftrace"), *FDateTime::Now().ToString());
+		}
+
+		return FPaths::IsRelative(Filename) ? FPaths::ProjectSavedDir() / TEXT("Traces") / Filename : Filename;
+	}
+
+	static bool ParseEvents(const FString& Filename, TArray<FEvent>& OutEvents)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Filename))
+		{
+			return false;
+		}
+
+		for (const FString& Line : Lines)
+		{
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("#")))
+			{
+				continue;
+			}
+
+			TArray<FString> Fields;
+			Line.ParseIntoArray(Fields, TEXT("\t"), /*InCullEmpty*/ false);
+			if (Fields.Num() != 6)
+			{
+				UE_LOG(LogGameFeatures, Warning, TEXT("Skipping malformed activation trace line: %s"), *Line);
+				continue;
+			}
+
+			int32 FoundType = INDEX_NONE;
+			for (int32 Index = 0; Index < UE_ARRAY_COUNT(EventTypeNames); ++Index)
+			{
+				if (Fields[1] == EventTypeNames[Index])
+				{
+					FoundType = Index;
+					break;
+				}
+			}
+
+			if (FoundType == INDEX_NONE)
+			{
+				UE_LOG(LogGameFeatures, Warning, TEXT("Skipping activation trace line of unknown type: %s"), *Line);
+				continue;
+			}
+
+			FEvent& Event = OutEvents.AddDefaulted_GetRef();
+			LexFromString(Event.Time, *Fields[0]);
+			Event.Type = static_cast<EEventType>(FoundType);
+			Event.Subject = Fields[2];
+			Event.Detail = Fields[3];
+			Event.Instance = Fields[4];
+			LexFromString(Event.DurationMs, *Fields[5]);
+		}
+
+		return true;
+	}
+}
+
+bool FGameFeatureActivationTrace::StartRecording(const FString& Filename)
+{
+	using namespace UE::GameFeaturesExtension::ActivationTrace;
+
+	if (Recording.IsValid())
+	{
+		StopRecording();
+	}
+
+	Recording = MakeUnique<FRecording>();
+	Recording->Filename = ResolveFilename(Filename);
+	Recording->StartTime = FPlatformTime::Seconds();
+	Recording->StartGameInstanceHandle = FWorldDelegates::OnStartGameInstance.AddStatic(&HandleStartGameInstance);
+
+	if (GEngine)
+	{
+		for (const FWorldContext& WorldContext : GEngine->GetWorldContexts())
+		{
+			BindGameInstance(WorldContext.OwningGameInstance);
+		}
+	}
+
+	bRecording = true;
+	ActionDepth = 0;
+
+	UE_LOG(LogGameFeatures, Log, TEXT("Recording game feature activations to %s"), *Recording->Filename);
+	return true;
+}
+
+bool FGameFeatureActivationTrace::StopRecording()
+{
+	using namespace UE::GameFeaturesExtension::ActivationTrace;
+
+	if (!Recording.IsValid())
+	{
+		return false;
+	}
+
+	bRecording = false;
+
+	FWorldDelegates::OnStartGameInstance.Remove(Recording->StartGameInstanceHandle);
+	for (const TPair<TWeakObjectPtr<UGameInstance>, FDelegateHandle>& Pair : Recording->LocalPlayerAddedHandles)
+	{
+		if (UGameInstance* GameInstance = Pair.Key.Get())
+		{
+			GameInstance->OnLocalPlayerAddedEvent.Remove(Pair.Value);
+		}
+	}
+
+	TStringBuilder<4096> Contents;
+	Contents << FileHeader << LINE_TERMINATOR;
+	for (const FEvent& Event : Recording->Events)
+	{
+		Contents.Appendf(TEXT("%.6f\t%s\t%s\t%s\t%s\t%.4f"), Event.Time, EventTypeNames[static_cast<int32>(Event.Type)], *Event.Subject, *Event.Detail, *Event.Instance, Event.DurationMs);
+		Contents << LINE_TERMINATOR;
+	}
+
+	const bool bSaved = FFileHelper::SaveStringToFile(Contents.ToView(), *Recording->Filename);
+	if (bSaved)
+	{
+		UE_LOG(LogGameFeatures, Log, TEXT("Wrote %d game feature activation events to %s"), Recording->Events.Num(), *Recording->Filename);
+	}
+	else
+	{
+		UE_LOG(LogGameFeatures, Error, TEXT("Failed to write the game feature activation trace to %s"), *Recording->Filename);
+	}
+
+	Recording.Reset();
+	return bSaved;
+}
+
+void FGameFeatureActivationTrace::RecordActionEvent(EEventType Type, const UObject& Action, double DurationMs)
+{
+	using namespace UE::GameFeaturesExtension::ActivationTrace;
+
+	if (Recording.IsValid())
+	{
+		FEvent& Event = AddEvent(Type);
+		Event.Subject = Action.GetPathName();
+		Event.DurationMs = DurationMs;
+	}
+}
+
+void FGameFeatureActivationTrace::RecordExtensionEventInternal(const AActor* Actor, FName EventName)
+{
+	using namespace UE::GameFeaturesExtension::ActivationTrace;
+
+	if (!Recording.IsValid() || (Actor == nullptr))
+	{
+		return;
+	}
+
+	if (Recording->FrameNumber != GFrameCounter)
+	{
+		Recording->FrameNumber = GFrameCounter;
+		Recording->FrameExtensionEvents.Reset();
+	}
+
+	bool bAlreadyRecorded = false;
+	Recording->FrameExtensionEvents.Add(TPair<FObjectKey, FName>(FObjectKey(Actor), EventName), &bAlreadyRecorded);
+	if (!bAlreadyRecorded)
+	{
+		FEvent& Event = AddEvent(EEventType::Extension);
+		Event.Subject = Actor->GetClass()->GetPathName();
+		Event.Detail = EventName.ToString();
+		Event.Instance = Actor->GetName();
+	}
+}
+
+bool FGameFeatureActivationTrace::Replay(const FString& Filename, int32 NumIterations, FOutputDevice& Ar)
+{
+	using namespace UE::GameFeaturesExtension::ActivationTrace;
+
+	const FString ResolvedFilename = ResolveFilename(Filename);
+
+	TArray<FEvent> Events;
+	if (!ParseEvents(ResolvedFilename, Events))
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Failed to read activation trace %s"), *ResolvedFilename);
+		return false;
+	}
+
+	if (bRecording)
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Activation traces can't be replayed while recording"));
+		return false;
+	}
+
+	const FScopedSynchronousGameFeatureTeardown SynchronousTeardown;
+	if (!SynchronousTeardown.IsActive())
+	{
+		Ar.Logf(ELogVerbosity::Error, TEXT("Activation trace replay aborted: teardown can't be made synchronous"));
+		return false;
+	}
+
+	// Replayed against copies of the recorded actions in a game instance of its own, the live features and worlds are never touched
+	const FGameFeatureTransientGameInstance GameInstance(TEXT("GameFeaturesExtensionReplay"));
+	UWorld& World = *GameInstance.Get()->GetWorld();
+	UGameFrameworkComponentManager* ComponentManager = UGameInstance::GetSubsystem<UGameFrameworkComponentManager>(GameInstance.Get());
+
+	auto RestrictToWorld = [&GameInstance](FGameFeatureStateChangeContext& Context)
+		{
+			Context.SetRequiredWorldContextHandle(GameInstance.GetContextHandle());
+		};
+
+	TMap<FString, TStrongObjectPtr<UGameFeatureAction>> ReplayActions;
+	auto FindReplayAction = [&ReplayActions](const FString& Path) -> UGameFeatureAction*
+		{
+			if (const TStrongObjectPtr<UGameFeatureAction>* Found = ReplayActions.Find(Path))
+			{
+				return Found->Get();
+			}
+
+			UGameFeatureAction* Action = Cast<UGameFeatureAction>(FSoftObjectPath(Path).TryLoad());
+			if (Action == nullptr)
+			{
+				return nullptr;
+			}
+
+			UGameFeatureAction* Copy = DuplicateObject<UGameFeatureAction>(Action, GetTransientPackage());
+			Copy->SetFlags(RF_Transient);
+			ReplayActions.Add(Path, TStrongObjectPtr<UGameFeatureAction>(Copy));
+			return Copy;
+		};
+
+	TArray<double> StepMs;
+	StepMs.SetNumZeroed(Events.Num());
+	int32 NumSkipped = 0;
+
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		TMap<FString, TWeakObjectPtr<AActor>> Receivers;
+		TMap<UGameFeatureAction*, int32> ActiveActions;
+		TSet<UGameFeatureAction*> LoadedActions;
+
+		for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+		{
+			const FEvent& Event = Events[EventIndex];
+
+			if ((Event.Type == EEventType::GameInstanceStart) || (Event.Type == EEventType::LocalPlayerAdded))
+			{
+				// The replay game instance already exists, the events only give context to the steps around them
+				NumSkipped += (Iteration == 0) ? 1 : 0;
+				continue;
+			}
+
+			if (Event.Type == EEventType::Extension)
+			{
+				UClass* ReceiverClass = FSoftClassPath(Event.Subject).TryLoadClass<AActor>();
+				if ((ReceiverClass == nullptr) || (ComponentManager == nullptr))
+				{
+					NumSkipped += (Iteration == 0) ? 1 : 0;
+					continue;
+				}
+
+				const double StartTime = FPlatformTime::Seconds();
+
+				TWeakObjectPtr<AActor>& Receiver = Receivers.FindOrAdd(Event.Instance);
+				if (!Receiver.IsValid())
+				{
+					FActorSpawnParameters SpawnParameters;
+					SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+					SpawnParameters.ObjectFlags = RF_Transient;
+					Receiver = World.SpawnActor<AActor>(ReceiverClass, FTransform::Identity, SpawnParameters);
+				}
+
+				if (Receiver.IsValid())
+				{
+					ComponentManager->SendExtensionEvent(Receiver.Get(), FName(*Event.Detail));
+				}
+
+				StepMs[EventIndex] += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+				continue;
+			}
+
+			UGameFeatureAction* Action = FindReplayAction(Event.Subject);
+			if (Action == nullptr)
+			{
+				if (Iteration == 0)
+				{
+					Ar.Logf(ELogVerbosity::Warning, TEXT("Activation trace step %d: %s could not be loaded"), EventIndex, *Event.Subject);
+					++NumSkipped;
+				}
+				continue;
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			switch (Event.Type)
+			{
+			case EEventType::Load:
+				Action->OnGameFeatureLoading();
+				LoadedActions.Add(Action);
+				break;
+			case EEventType::Unload:
+				Action->OnGameFeatureUnloading();
+				LoadedActions.Remove(Action);
+				break;
+			case EEventType::Activate:
+				{
+					FGameFeatureActivatingContext Context;
+					RestrictToWorld(Context);
+					Action->OnGameFeatureActivating(Context);
+					++ActiveActions.FindOrAdd(Action);
+				}
+				break;
+			case EEventType::Deactivate:
+				{
+					FGameFeatureDeactivatingContext Context(TEXTVIEW("GameFeaturesExtensionReplay"), [](FStringView) {});
+					RestrictToWorld(Context);
+					Action->OnGameFeatureDeactivating(Context);
+					if (int32* Count = ActiveActions.Find(Action); Count && (--(*Count) == 0))
+					{
+						ActiveActions.Remove(Action);
+					}
+				}
+				break;
+			default:
+				break;
+			}
+			StepMs[EventIndex] += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		// Traces stopped while features were active would leave them active for the next iteration
+		for (const TPair<UGameFeatureAction*, int32>& Pair : ActiveActions)
+		{
+			for (int32 Count = 0; Count < Pair.Value; ++Count)
+			{
+				FGameFeatureDeactivatingContext Context(TEXTVIEW("GameFeaturesExtensionReplay"), [](FStringView) {});
+				RestrictToWorld(Context);
+				Pair.Key->OnGameFeatureDeactivating(Context);
+			}
+		}
+
+		for (UGameFeatureAction* Action : LoadedActions)
+		{
+			Action->OnGameFeatureUnloading();
+		}
+
+		for (const TPair<FString, TWeakObjectPtr<AActor>>& Pair : Receivers)
+		{
+			if (AActor* Receiver = Pair.Value.Get())
+			{
+				Receiver->Destroy();
+			}
+		}
+	}
+
+	double TotalMs = 0.0;
+	double TotalRecordedMs = 0.0;
+	for (int32 EventIndex = 0; EventIndex < Events.Num(); ++EventIndex)
+	{
+		const FEvent& Event = Events[EventIndex];
+		const double AverageMs = StepMs[EventIndex] / NumIterations;
+
+		Ar.Logf(TEXT("%5d %10.3fs %-18s %9.3f ms (recorded %9.3f ms)  %s %s"),
+			EventIndex, Event.Time, EventTypeNames[static_cast<int32>(Event.Type)], AverageMs, Event.DurationMs, *Event.Subject, *Event.Detail);
+
+		TotalMs += AverageMs;
+		TotalRecordedMs += Event.DurationMs;
+	}
+
+	Ar.Logf(TEXT("Replayed %d steps of %s %d times: %.3f ms per iteration (recorded %.3f ms), %d steps skipped"),
+		Events.Num(), *ResolvedFilename, NumIterations, TotalMs, TotalRecordedMs, NumSkipped);
+
+	for (const TPair<FString, TStrongObjectPtr<UGameFeatureAction>>& Pair : ReplayActions)
+	{
+		Pair.Value->MarkAsGarbage();
+	}
+
+	return true;
+}
+
+namespace UE::GameFeaturesExtension::ActivationTrace
+{
+	static FAutoConsoleCommand StartCommand(
+		TEXT("GameFeaturesExtension.Trace.Start"),
+		TEXT("Starts recording game feature lifecycle transitions, game instance starts, local players and extension events. Usage: GameFeaturesExtension.Trace.Start [Filename]"),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+			{
+				FGameFeatureActivationTrace::StartRecording(Args.IsValidIndex(0) ? Args[0] : FString());
+			}));
+
+	static FAutoConsoleCommand StopCommand(
+		TEXT("GameFeaturesExtension.Trace.Stop"),
+		TEXT("Stops recording and writes the activation trace."),
+		FConsoleCommandDelegate::CreateLambda([]()
+			{
+				FGameFeatureActivationTrace::StopRecording();
+			}));
+
+	static FAutoConsoleCommandWithArgsAndOutputDevice ReplayCommand(
+		TEXT("GameFeaturesExtension.Trace.Replay"),
+		TEXT("Replays an activation trace with copies of the recorded actions in a transient game instance and reports the duration of every step. Relative paths are under Saved/Traces. Usage: GameFeaturesExtension.Trace.Replay Filename [NumIterations=1]"),
+		FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, FOutputDevice& Ar)
+			{
+				if (!Args.IsValidIndex(0))
+				{
+					Ar.Logf(ELogVerbosity::Error, TEXT("Usage: GameFeaturesExtension.Trace.Replay Filename [NumIterations=1]"));
+					return;
+				}
+
+				const int32 NumIterations = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 1);
+				FGameFeatureActivationTrace::Replay(Args[0], NumIterations, Ar);
+			}));
+}
+
+#endif // !UE_BUILD_SHIPPING
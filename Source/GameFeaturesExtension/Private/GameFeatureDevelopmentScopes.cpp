@@ -0,0 +1,72 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureDevelopmentScopes.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFeaturesSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+//////////////////////////////////////////////////////////////////////
+// FGameFeatureTransientGameInstance
+
+FGameFeatureTransientGameInstance::FGameFeatureTransientGameInstance(const FString& Name)
+{
+	GameInstance.Reset(NewObject<UGameInstance>(GEngine));
+	GameInstance->InitializeStandalone(*Name);
+}
+
+FGameFeatureTransientGameInstance::~FGameFeatureTransientGameInstance()
+{
+	UWorld* World = GameInstance->GetWorld();
+	GameInstance->Shutdown();
+
+	if (World)
+	{
+		World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+		GEngine->DestroyWorldContext(World);
+	}
+}
+
+FName FGameFeatureTransientGameInstance::GetContextHandle() const
+{
+	return GameInstance->GetWorldContext()->ContextHandle;
+}
+
+//////////////////////////////////////////////////////////////////////
+// FScopedSynchronousGameFeatureTeardown
+
+FScopedSynchronousGameFeatureTeardown::FScopedSynchronousGameFeatureTeardown()
+{
+	for (const TCHAR* Name : { TEXT("GameFeaturesExtension.Teardown.BudgetMs"), TEXT("GameFeaturesExtension.Teardown.RetainSeconds") })
+	{
+		if (IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name))
+		{
+			Overrides.Add({ Variable, Variable->GetString(), Variable->GetFlags() & ECVF_SetByMask });
+			Variable->Set(TEXT("0"), ECVF_SetByCode);
+
+			if (Variable->GetFloat() != 0.f)
+			{
+				UE_LOG(LogGameFeatures, Error, TEXT("Can't tear down synchronously, %s is set to %s with a priority higher than code. Reset it before running."),
+					Name, *Variable->GetString());
+				bActive = false;
+			}
+		}
+	}
+}
+
+FScopedSynchronousGameFeatureTeardown::~FScopedSynchronousGameFeatureTeardown()
+{
+	for (const FOverride& Override : Overrides)
+	{
+		// Restore the priority along with the value, so the variable can still be changed the way it could before
+		Override.Variable->Set(*Override.PriorValue, ECVF_SetByCode);
+		Override.Variable->SetFlags(static_cast<EConsoleVariableFlags>((Override.Variable->GetFlags() & ~ECVF_SetByMask) | Override.PriorSetBy));
+	}
+}
+
+#endif // !UE_BUILD_SHIPPING
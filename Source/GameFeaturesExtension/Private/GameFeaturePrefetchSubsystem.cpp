@@ -0,0 +1,522 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#include "GameFeaturePrefetchSubsystem.h"
+
+#include "GameFeatureActionSet.h"
+#include "GameFeatureData.h"
+#include "GameFeatureStreamingManager.h"
+#include "GameFeatureTypes.h"
+#include "GameFeaturesSubsystem.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/UObjectGlobals.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeaturePrefetchSubsystem)
+
+namespace UE::GameFeaturesExtension::Prefetch
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(
+		TEXT("GameFeaturesExtension.Prefetch.Enabled"),
+		bEnabled,
+		TEXT("If false, no new prefetch requests are started. Features already prefetched stay resident."),
+		ECVF_Default);
+
+	static float MaxFrameMs = 20.f;
+	static FAutoConsoleVariableRef CVarMaxFrameMs(
+		TEXT("GameFeaturesExtension.Prefetch.MaxFrameMs"),
+		MaxFrameMs,
+		TEXT("New prefetch requests are only started after frames that took at most this long, in milliseconds."),
+		ECVF_Default);
+
+	static int32 MemoryCeilingMB = 0;
+	static FAutoConsoleVariableRef CVarMemoryCeilingMB(
+		TEXT("GameFeaturesExtension.Prefetch.MemoryCeilingMB"),
+		MemoryCeilingMB,
+		TEXT("While the process uses more physical memory than this, no prefetch requests are started and the least likely prefetched features are evicted. 0 disables the ceiling."),
+		ECVF_Default);
+
+	static bool IsAboveMemoryCeiling()
+	{
+		const uint64 CeilingBytes = static_cast<uint64>(FMath::Max(0, MemoryCeilingMB)) * 1024 * 1024;
+		return (CeilingBytes > 0) && (FPlatformMemory::GetStats().UsedPhysical > CeilingBytes);
+	}
+
+	/** Bundles the running process loads when activating a feature */
+	static TArray<FName> GetBundlesForProcess()
+	{
+		TArray<FName> Bundles;
+		if (!IsRunningDedicatedServer())
+		{
+			Bundles.Add(UGameFeaturesSubsystemSettings::LoadStateClient);
+		}
+		if (!IsRunningClientOnly())
+		{
+			Bundles.Add(UGameFeaturesSubsystemSettings::LoadStateServer);
+		}
+		return Bundles;
+	}
+
+	/** Adds the action set, its included sets and the plugins they enable to OutKeys */
+	static void GatherDependencies(const UGameFeatureActionSet& ActionSet, TSet<FString>& OutKeys)
+	{
+		bool bAlreadyVisited = false;
+		OutKeys.Add(FSoftObjectPath(&ActionSet).ToString(), &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			return;
+		}
+
+		for (const FGameFeaturePluginURL& PluginURL : ActionSet.GameFeaturesToEnable)
+		{
+			if (PluginURL.IsValid())
+			{
+				OutKeys.Add(PluginURL.GetURL());
+			}
+		}
+
+		for (const UGameFeatureActionSet* Included : ActionSet.IncludedActionSets)
+		{
+			if (Included)
+			{
+				GatherDependencies(*Included, OutKeys);
+			}
+		}
+	}
+
+	static const TCHAR* GetStateName(uint8 State)
+	{
+		static const TCHAR* Names[] = { TEXT("Pending"), TEXT("Mounting"), TEXT("Loading"), TEXT("Resident"), TEXT("Evicted") };
+		return State < UE_ARRAY_COUNT(Names) ? Names[State] : TEXT("Unknown");
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("GameFeaturesExtension.Prefetch.Dump"),
+		TEXT("Lists the features being prefetched with their likelihood and state."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+			{
+				if (const UGameFeaturePrefetchSubsystem* Prefetch = GEngine ? GEngine->GetEngineSubsystem<UGameFeaturePrefetchSubsystem>() : nullptr)
+				{
+					Prefetch->Dump(Ar);
+				}
+			}));
+}
+
+void UGameFeaturePrefetchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &ThisClass::HandlePostGarbageCollect);
+}
+
+void UGameFeaturePrefetchSubsystem::Deinitialize()
+{
+	ClearPrefetchTargets();
+
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	PostGarbageCollectHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+void UGameFeaturePrefetchSubsystem::SetPrefetchTargets(const UGameFeatureActionSet* CurrentActionSet, const TArray<FGameFeaturePrefetchCandidate>& Candidates)
+{
+	using namespace UE::GameFeaturesExtension::Prefetch;
+
+	Excluded.Reset();
+	if (CurrentActionSet)
+	{
+		GatherDependencies(*CurrentActionSet, Excluded);
+	}
+
+	PreviousFeatures = MoveTemp(Features);
+	Features.Reset();
+
+	for (const FGameFeaturePrefetchCandidate& Candidate : Candidates)
+	{
+		if (Candidate.ActionSet.IsNull())
+		{
+			continue;
+		}
+
+		const FSoftObjectPath ActionSetPath = Candidate.ActionSet.ToSoftObjectPath();
+		AddFeature(ActionSetPath.ToString(), FString(), ActionSetPath, Candidate.Likelihood);
+
+		// Dependencies of sets that aren't loaded yet are added once their prefetch completes
+		if (const UGameFeatureActionSet* ActionSet = Candidate.ActionSet.Get())
+		{
+			AddDependencies(*ActionSet, Candidate.Likelihood);
+		}
+	}
+
+	// Everything no candidate reaches anymore, including what the current action set now depends on, is released
+	for (TPair<FString, FFeature>& Pair : PreviousFeatures)
+	{
+		Evict(Pair.Value);
+	}
+	PreviousFeatures.Reset();
+
+	UE_LOG(LogGameFeatures, Verbose, TEXT("Prefetching %d features for %d candidates of %s"), Features.Num(), Candidates.Num(), *GetPathNameSafe(CurrentActionSet));
+
+	if (HasPendingWork())
+	{
+		StartTicking();
+	}
+}
+
+void UGameFeaturePrefetchSubsystem::ClearPrefetchTargets()
+{
+	for (TPair<FString, FFeature>& Pair : Features)
+	{
+		Evict(Pair.Value);
+	}
+	Features.Reset();
+	Excluded.Reset();
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	TickerHandle.Reset();
+}
+
+int32 UGameFeaturePrefetchSubsystem::GetNumResidentFeatures() const
+{
+	int32 NumResident = 0;
+	for (const TPair<FString, FFeature>& Pair : Features)
+	{
+		NumResident += (Pair.Value.State == EFeatureState::Resident) ? 1 : 0;
+	}
+	return NumResident;
+}
+
+void UGameFeaturePrefetchSubsystem::Dump(FOutputDevice& Ar) const
+{
+	TArray<const TPair<FString, FFeature>*> SortedFeatures;
+	for (const TPair<FString, FFeature>& Pair : Features)
+	{
+		SortedFeatures.Add(&Pair);
+	}
+
+	SortedFeatures.Sort([](const TPair<FString, FFeature>& A, const TPair<FString, FFeature>& B)
+		{
+			return A.Value.Likelihood > B.Value.Likelihood;
+		});
+
+	for (const TPair<FString, FFeature>* Pair : SortedFeatures)
+	{
+		Ar.Logf(TEXT("  %-10s  Likelihood=%.2f  %s"),
+			UE::GameFeaturesExtension::Prefetch::GetStateName(static_cast<uint8>(Pair->Value.State)), Pair->Value.Likelihood, *Pair->Key);
+	}
+
+	Ar.Logf(TEXT("%d features prefetched, %d resident, %d excluded as dependencies of the current action set"),
+		Features.Num(), GetNumResidentFeatures(), Excluded.Num());
+}
+
+bool UGameFeaturePrefetchSubsystem::Tick(float DeltaTime)
+{
+	using namespace UE::GameFeaturesExtension::Prefetch;
+
+	if (IsAboveMemoryCeiling())
+	{
+		FString Key;
+		if (FFeature* Feature = bCanEvict ? FindFeature({ EFeatureState::Loading, EFeatureState::Resident }, /*bMostLikely*/ false, &Key) : nullptr)
+		{
+			UE_LOG(LogGameFeatures, Verbose, TEXT("Above the prefetch memory ceiling of %d MB, evicting %s"), MemoryCeilingMB, *Key);
+			Evict(*Feature);
+			bCanEvict = false;
+		}
+	}
+	// One request at a time, prefetching shouldn't compete with loads the game is waiting on
+	else if (bEnabled && (DeltaTime * 1000.f <= MaxFrameMs) && !FindFeature({ EFeatureState::Mounting, EFeatureState::Loading }, /*bMostLikely*/ true))
+	{
+		FString Key;
+		if (FFeature* Feature = FindFeature({ EFeatureState::Pending }, /*bMostLikely*/ true, &Key))
+		{
+			StartPrefetch(Key, *Feature);
+		}
+	}
+
+	// Returning false removes the ticker, garbage collections and new targets start it again
+	if (!HasPendingWork())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void UGameFeaturePrefetchSubsystem::StartTicking()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &ThisClass::Tick));
+	}
+}
+
+bool UGameFeaturePrefetchSubsystem::HasPendingWork()
+{
+	return FindFeature({ EFeatureState::Pending, EFeatureState::Mounting, EFeatureState::Loading }, /*bMostLikely*/ true) != nullptr;
+}
+
+bool UGameFeaturePrefetchSubsystem::AddFeature(const FString& Key, const FString& PluginURL, const FSoftObjectPath& ActionSet, float Likelihood)
+{
+	if (Excluded.Contains(Key))
+	{
+		return false;
+	}
+
+	if (FFeature* Existing = Features.Find(Key))
+	{
+		if (Existing->Likelihood >= Likelihood)
+		{
+			return false;
+		}
+
+		Existing->Likelihood = Likelihood;
+		return true;
+	}
+
+	FFeature Feature;
+	if (!PreviousFeatures.RemoveAndCopyValue(Key, Feature) || (Feature.State == EFeatureState::Evicted))
+	{
+		Feature = FFeature();
+		Feature.PluginURL = PluginURL;
+		Feature.ActionSet = ActionSet;
+	}
+
+	Feature.Likelihood = Likelihood;
+	Features.Add(Key, MoveTemp(Feature));
+	return true;
+}
+
+void UGameFeaturePrefetchSubsystem::AddDependencies(const UGameFeatureActionSet& ActionSet, float Likelihood)
+{
+	for (const FGameFeaturePluginURL& PluginURL : ActionSet.GameFeaturesToEnable)
+	{
+		if (PluginURL.IsValid())
+		{
+			AddFeature(PluginURL.GetURL(), PluginURL.GetURL(), FSoftObjectPath(), Likelihood);
+		}
+	}
+
+	for (const UGameFeatureActionSet* Included : ActionSet.IncludedActionSets)
+	{
+		if (Included == nullptr)
+		{
+			continue;
+		}
+
+		const FSoftObjectPath IncludedPath(Included);
+		if (AddFeature(IncludedPath.ToString(), FString(), IncludedPath, Likelihood))
+		{
+			AddDependencies(*Included, Likelihood);
+		}
+	}
+}
+
+void UGameFeaturePrefetchSubsystem::StartPrefetch(const FString& Key, FFeature& Feature)
+{
+	UGameFeaturesSubsystem& GameFeatures = UGameFeaturesSubsystem::Get();
+
+	if (Feature.ActionSet.IsValid())
+	{
+		const FPrimaryAssetId AssetId = UAssetManager::Get().GetPrimaryAssetIdForPath(Feature.ActionSet);
+		if (AssetId.IsValid())
+		{
+			LoadBundles(Key, AssetId);
+		}
+		else
+		{
+			// Not a registered primary asset, only the set itself can be loaded
+			Feature.State = EFeatureState::Loading;
+			Feature.Handle = FGameFeatureStreamingManager::Get().RequestAsyncLoad({ Feature.ActionSet }, EGameFeatureStreamingPriority::Cosmetic,
+				FStreamableDelegate::CreateUObject(this, &ThisClass::HandleLoadComplete, Key), FString::Printf(TEXT("Prefetch %s"), *Key));
+			if (!Feature.Handle.IsValid())
+			{
+				HandleLoadComplete(Key);
+			}
+		}
+		return;
+	}
+
+	if (GameFeatures.IsGameFeaturePluginActive(Feature.PluginURL))
+	{
+		// Activated by something else in the meantime, its data is resident anyway
+		Feature.State = EFeatureState::Resident;
+		return;
+	}
+
+	if (GameFeatures.IsGameFeaturePluginRegistered(Feature.PluginURL))
+	{
+		if (const UGameFeatureData* GameFeatureData = GameFeatures.GetGameFeatureDataForRegisteredPluginByURL(Feature.PluginURL))
+		{
+			LoadBundles(Key, GameFeatureData->GetPrimaryAssetId());
+			return;
+		}
+	}
+
+	// Only mount plugins nothing else is moving. A plugin in transition may be on its way to active, requesting Registered would override that target.
+	const EGameFeaturePluginState PluginState = GameFeatures.GetPluginState(Feature.PluginURL);
+	if ((PluginState != EGameFeaturePluginState::Installed) && (PluginState != EGameFeaturePluginState::UnknownStatus))
+	{
+		UE_LOG(LogGameFeatures, Verbose, TEXT("Not prefetching %s, the plugin is changing state already"), *Feature.PluginURL);
+		Feature.State = EFeatureState::Evicted;
+		return;
+	}
+
+	UE_LOG(LogGameFeatures, Verbose, TEXT("Prefetch mounting %s"), *Feature.PluginURL);
+
+	Feature.State = EFeatureState::Mounting;
+	Feature.bMountedByPrefetch = true;
+	GameFeatures.ChangeGameFeatureTargetState(Feature.PluginURL, EGameFeatureTargetState::Registered,
+		FGameFeaturePluginChangeStateComplete::CreateWeakLambda(this, [this, Key, PluginURL = Feature.PluginURL](const UE::GameFeatures::FResult& Result)
+			{
+				FFeature* Mounted = Features.Find(Key);
+				if ((Mounted == nullptr) || (Mounted->State != EFeatureState::Mounting))
+				{
+					// Evicted or no longer a target while mounting, Evict left the plugin to be unmounted here
+					if (!Result.HasError())
+					{
+						UnmountPlugin(PluginURL);
+					}
+					return;
+				}
+
+				const UGameFeatureData* GameFeatureData = Result.HasError() ? nullptr : UGameFeaturesSubsystem::Get().GetGameFeatureDataForRegisteredPluginByURL(Mounted->PluginURL);
+				if (GameFeatureData == nullptr)
+				{
+					UE_LOG(LogGameFeatures, Warning, TEXT("Failed to prefetch %s: %s"), *Key, Result.HasError() ? *Result.GetError() : TEXT("no game feature data"));
+					Mounted->State = EFeatureState::Evicted;
+					return;
+				}
+
+				LoadBundles(Key, GameFeatureData->GetPrimaryAssetId());
+			}));
+}
+
+void UGameFeaturePrefetchSubsystem::LoadBundles(const FString& Key, const FPrimaryAssetId& AssetId)
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	// Loaded through our own handle rather than LoadPrimaryAsset, so evicting never unloads bundles the game requested itself
+	TArray<FSoftObjectPath> Assets;
+	Assets.Add(AssetManager.GetPrimaryAssetPath(AssetId));
+	for (const FName Bundle : UE::GameFeaturesExtension::Prefetch::GetBundlesForProcess())
+	{
+		for (const FTopLevelAssetPath& AssetPath : AssetManager.GetAssetBundleEntry(AssetId, Bundle).AssetPaths)
+		{
+			Assets.AddUnique(FSoftObjectPath(AssetPath));
+		}
+	}
+
+	Assets.RemoveAll([](const FSoftObjectPath& Asset)
+		{
+			return Asset.IsNull();
+		});
+
+	FFeature& Feature = Features.FindChecked(Key);
+	Feature.State = EFeatureState::Loading;
+
+	UE_LOG(LogGameFeatures, Verbose, TEXT("Prefetching %d assets of %s"), Assets.Num(), *Key);
+
+	TSharedPtr<FStreamableHandle> Handle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(MoveTemp(Assets), EGameFeatureStreamingPriority::Cosmetic,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleLoadComplete, Key), FString::Printf(TEXT("Prefetch %s"), *Key));
+
+	if (Handle.IsValid())
+	{
+		Features.FindChecked(Key).Handle = MoveTemp(Handle);
+	}
+	else
+	{
+		HandleLoadComplete(Key);
+	}
+}
+
+void UGameFeaturePrefetchSubsystem::HandleLoadComplete(FString Key)
+{
+	FFeature* Feature = Features.Find(Key);
+	if ((Feature == nullptr) || (Feature->State != EFeatureState::Loading))
+	{
+		return;
+	}
+
+	Feature->State = EFeatureState::Resident;
+
+	// Adding dependencies may reallocate the map, don't use Feature past this point
+	const float Likelihood = Feature->Likelihood;
+	if (const UGameFeatureActionSet* ActionSet = Cast<UGameFeatureActionSet>(Feature->ActionSet.ResolveObject()))
+	{
+		AddDependencies(*ActionSet, Likelihood);
+	}
+}
+
+void UGameFeaturePrefetchSubsystem::HandlePostGarbageCollect()
+{
+	bCanEvict = true;
+
+	// Resident features don't keep the ticker alive, collections are where the memory ceiling is checked again
+	if (UE::GameFeaturesExtension::Prefetch::IsAboveMemoryCeiling() && FindFeature({ EFeatureState::Loading, EFeatureState::Resident }, /*bMostLikely*/ false))
+	{
+		StartTicking();
+	}
+}
+
+void UGameFeaturePrefetchSubsystem::Evict(FFeature& Feature)
+{
+	if (Feature.Handle.IsValid())
+	{
+		// Cancels the loads still in flight and releases the ones that completed
+		Feature.Handle->CancelHandle();
+		Feature.Handle.Reset();
+	}
+
+	// Plugins still mounting are unmounted once their registration completes
+	if (Feature.bMountedByPrefetch && (Feature.State != EFeatureState::Mounting))
+	{
+		UnmountPlugin(Feature.PluginURL);
+	}
+
+	Feature.bMountedByPrefetch = false;
+	Feature.State = EFeatureState::Evicted;
+}
+
+void UGameFeaturePrefetchSubsystem::UnmountPlugin(const FString& PluginURL)
+{
+	UGameFeaturesSubsystem* GameFeatures = GEngine ? GEngine->GetEngineSubsystem<UGameFeaturesSubsystem>() : nullptr;
+	if ((GameFeatures == nullptr) || (GameFeatures->GetPluginState(PluginURL) != EGameFeaturePluginState::Registered))
+	{
+		// Loaded or activated by the game in the meantime, it owns the plugin now
+		return;
+	}
+
+	UE_LOG(LogGameFeatures, Verbose, TEXT("Prefetch unmounting %s"), *PluginURL);
+	GameFeatures->ChangeGameFeatureTargetState(PluginURL, EGameFeatureTargetState::Installed, FGameFeaturePluginChangeStateComplete());
+}
+
+UGameFeaturePrefetchSubsystem::FFeature* UGameFeaturePrefetchSubsystem::FindFeature(TConstArrayView<EFeatureState> States, bool bMostLikely, FString* OutKey)
+{
+	TPair<FString, FFeature>* Best = nullptr;
+	for (TPair<FString, FFeature>& Pair : Features)
+	{
+		if (!States.Contains(Pair.Value.State))
+		{
+			continue;
+		}
+
+		const bool bIsBetter = (Best == nullptr) ||
+			(bMostLikely ? (Pair.Value.Likelihood > Best->Value.Likelihood) : (Pair.Value.Likelihood < Best->Value.Likelihood));
+		if (bIsBetter)
+		{
+			Best = &Pair;
+		}
+	}
+
+	if (Best && OutKey)
+	{
+		*OutKey = Best->Key;
+	}
+	return Best ? &Best->Value : nullptr;
+}
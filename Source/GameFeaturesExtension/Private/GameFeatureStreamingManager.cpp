@@ -0,0 +1,287 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#include "GameFeatureStreamingManager.h"
+
+#include "GameFeaturesExtensionStats.h"
+#include "Engine/AssetManager.h"
+#include "Engine/LevelStreaming.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+namespace UE::GameFeaturesExtension::Streaming
+{
+	static int32 MaxInFlight = 4;
+	static FAutoConsoleVariableRef CVarMaxInFlight(
+		TEXT("GameFeaturesExtension.Streaming.MaxInFlight"),
+		MaxInFlight,
+		TEXT("Maximum number of Visual and Cosmetic game feature load requests (including streaming level instances) loading at the same time. Gameplay critical requests are never held back."),
+		ECVF_Default);
+
+	static int32 MaxInFlightCosmetic = 1;
+	static FAutoConsoleVariableRef CVarMaxInFlightCosmetic(
+		TEXT("GameFeaturesExtension.Streaming.MaxInFlightCosmetic"),
+		MaxInFlightCosmetic,
+		TEXT("Maximum number of Cosmetic game feature load requests loading at the same time."),
+		ECVF_Default);
+
+	static TAsyncLoadPriority GetAsyncLoadPriority(EGameFeatureStreamingPriority Priority)
+	{
+		switch (Priority)
+		{
+		case EGameFeatureStreamingPriority::GameplayCritical:
+			return FStreamableManager::AsyncLoadHighPriority;
+		case EGameFeatureStreamingPriority::Visual:
+			return FStreamableManager::AsyncLoadHighPriority / 2;
+		default:
+			return FStreamableManager::DefaultAsyncLoadPriority;
+		}
+	}
+
+	static const TCHAR* GetPriorityName(EGameFeatureStreamingPriority Priority)
+	{
+		switch (Priority)
+		{
+		case EGameFeatureStreamingPriority::GameplayCritical:
+			return TEXT("GameplayCritical");
+		case EGameFeatureStreamingPriority::Visual:
+			return TEXT("Visual");
+		default:
+			return TEXT("Cosmetic");
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpCommand(
+		TEXT("GameFeaturesExtension.Streaming.Dump"),
+		TEXT("Lists the game feature load requests that are queued or loading."),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+			{
+				FGameFeatureStreamingManager::Get().Dump(Ar);
+			}));
+}
+
+bool FGameFeatureStreamingManager::FRequest::IsDone() const
+{
+	for (const TWeakPtr<FStreamableHandle>& WeakHandle : Handles)
+	{
+		const TSharedPtr<FStreamableHandle> Handle = WeakHandle.Pin();
+		if (Handle.IsValid() && !Handle->HasLoadCompleted() && !Handle->WasCanceled())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FGameFeatureStreamingManager& FGameFeatureStreamingManager::Get()
+{
+	static FGameFeatureStreamingManager Instance;
+	return Instance;
+}
+
+TSharedPtr<FStreamableHandle> FGameFeatureStreamingManager::RequestAsyncLoad(TArray<FSoftObjectPath> Assets, EGameFeatureStreamingPriority Priority,
+	FStreamableDelegate OnComplete, const FString& DebugName)
+{
+	Assets.RemoveAll([](const FSoftObjectPath& Asset)
+		{
+			return Asset.IsNull();
+		});
+
+	if (Assets.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	Assets.Sort([](const FSoftObjectPath& A, const FSoftObjectPath& B)
+		{
+			return A.LexicalLess(B);
+		});
+
+	for (int32 Index = Assets.Num() - 1; Index > 0; --Index)
+	{
+		if (Assets[Index] == Assets[Index - 1])
+		{
+			Assets.RemoveAt(Index, 1, EAllowShrinking::No);
+		}
+	}
+
+	const bool bResident = !Assets.ContainsByPredicate([](const FSoftObjectPath& Asset)
+		{
+			return Asset.ResolveObject() == nullptr;
+		});
+
+	auto FindRequest = [&Assets](TArray<FRequest>& Requests)
+		{
+			return Requests.FindByPredicate([&Assets](const FRequest& Request)
+				{
+					return Request.Assets == Assets;
+				});
+		};
+
+	FRequest* InFlightRequest = bResident ? nullptr : FindRequest(InFlight);
+	FRequest* QueuedRequest = (bResident || InFlightRequest) ? nullptr : FindRequest(Queued);
+
+	// Identical loads already in flight share their slot, nothing is queued behind them
+	const bool bStartNow = bResident || InFlightRequest || (Priority == EGameFeatureStreamingPriority::GameplayCritical);
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets, MoveTemp(OnComplete),
+		UE::GameFeaturesExtension::Streaming::GetAsyncLoadPriority(Priority), /*bManageActiveHandle*/ false, /*bStartStalled*/ !bStartNow, DebugName);
+
+	if (!Handle.IsValid() || bResident)
+	{
+		return Handle;
+	}
+
+	if (InFlightRequest)
+	{
+		InFlightRequest->Handles.Add(Handle);
+	}
+	else if (QueuedRequest)
+	{
+		QueuedRequest->Handles.Add(Handle);
+		if (Priority < QueuedRequest->Priority)
+		{
+			// Requested more urgently by another feature, promote it for everyone waiting on it
+			QueuedRequest->Priority = Priority;
+			if (Priority == EGameFeatureStreamingPriority::GameplayCritical)
+			{
+				StartRequest(*QueuedRequest);
+			}
+		}
+	}
+	else
+	{
+		FRequest& Request = (bStartNow ? InFlight : Queued).AddDefaulted_GetRef();
+		Request.Assets = MoveTemp(Assets);
+		Request.Handles.Add(Handle);
+		Request.Priority = Priority;
+		Request.Serial = NextSerial++;
+		Request.DebugName = DebugName;
+	}
+
+	Pump();
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGameFeatureStreamingManager::Tick));
+	}
+
+	return Handle;
+}
+
+void FGameFeatureStreamingManager::TrackLevelStreaming(ULevelStreaming* Level, EGameFeatureStreamingPriority Priority)
+{
+	if ((Level == nullptr) || Level->IsLevelLoaded())
+	{
+		return;
+	}
+
+	TrackedLevels.Add({ Level, Priority });
+
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGameFeatureStreamingManager::Tick));
+	}
+}
+
+void FGameFeatureStreamingManager::Dump(FOutputDevice& Ar) const
+{
+	using namespace UE::GameFeaturesExtension::Streaming;
+
+	for (const FRequest& Request : InFlight)
+	{
+		Ar.Logf(TEXT("  Loading  %-16s  %s (%d assets, %d requesters)"), GetPriorityName(Request.Priority), *Request.DebugName, Request.Assets.Num(), Request.Handles.Num());
+	}
+
+	for (const FTrackedLevel& Tracked : TrackedLevels)
+	{
+		Ar.Logf(TEXT("  Loading  %-16s  %s (level)"), GetPriorityName(Tracked.Priority), *GetPathNameSafe(Tracked.Level.Get()));
+	}
+
+	for (const FRequest& Request : Queued)
+	{
+		Ar.Logf(TEXT("  Queued   %-16s  %s (%d assets, %d requesters)"), GetPriorityName(Request.Priority), *Request.DebugName, Request.Assets.Num(), Request.Handles.Num());
+	}
+
+	Ar.Logf(TEXT("%d requests loading, %d levels streaming, %d requests queued"), InFlight.Num(), TrackedLevels.Num(), Queued.Num());
+}
+
+bool FGameFeatureStreamingManager::Tick(float DeltaTime)
+{
+	Pump();
+
+	if (Queued.IsEmpty() && InFlight.IsEmpty() && TrackedLevels.IsEmpty())
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void FGameFeatureStreamingManager::Pump()
+{
+	using namespace UE::GameFeaturesExtension::Streaming;
+
+	InFlight.RemoveAllSwap([](const FRequest& Request) { return Request.IsDone(); }, EAllowShrinking::No);
+	Queued.RemoveAll([](const FRequest& Request) { return Request.IsDone(); });
+	TrackedLevels.RemoveAllSwap([](const FTrackedLevel& Tracked)
+		{
+			const ULevelStreaming* Level = Tracked.Level.Get();
+			return !Level || Level->IsLevelLoaded() || (Level->GetLevelStreamingState() == ELevelStreamingState::FailedToLoad);
+		}, EAllowShrinking::No);
+
+	Queued.Sort([](const FRequest& A, const FRequest& B)
+		{
+			return (A.Priority != B.Priority) ? (A.Priority < B.Priority) : (A.Serial < B.Serial);
+		});
+
+	// Strictly in order, a request that has to wait holds back everything less urgent
+	while (!Queued.IsEmpty())
+	{
+		const EGameFeatureStreamingPriority Priority = Queued[0].Priority;
+		const bool bCanStart = (Priority == EGameFeatureStreamingPriority::GameplayCritical) ||
+			((CountInFlight() < MaxInFlight) && ((Priority != EGameFeatureStreamingPriority::Cosmetic) || (CountInFlight(Priority) < MaxInFlightCosmetic)));
+
+		if (!bCanStart)
+		{
+			break;
+		}
+
+		StartRequest(Queued[0]);
+	}
+}
+
+void FGameFeatureStreamingManager::StartRequest(FRequest& Request)
+{
+	const int32 Index = UE_PTRDIFF_TO_INT32(&Request - Queued.GetData());
+	check(Queued.IsValidIndex(Index));
+
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureStreaming Start"), TEXT("%s (%d assets)"), *Request.DebugName, Request.Assets.Num());
+
+	for (const TWeakPtr<FStreamableHandle>& WeakHandle : Request.Handles)
+	{
+		if (const TSharedPtr<FStreamableHandle> Handle = WeakHandle.Pin(); Handle.IsValid() && Handle->IsStalled())
+		{
+			Handle->StartStalledHandle();
+		}
+	}
+
+	InFlight.Add(MoveTemp(Request));
+	Queued.RemoveAt(Index);
+}
+
+int32 FGameFeatureStreamingManager::CountInFlight(TOptional<EGameFeatureStreamingPriority> Priority) const
+{
+	int32 Count = 0;
+	for (const FRequest& Request : InFlight)
+	{
+		Count += (!Priority.IsSet() || (Request.Priority == Priority.GetValue())) ? 1 : 0;
+	}
+
+	for (const FTrackedLevel& Tracked : TrackedLevels)
+	{
+		Count += (!Priority.IsSet() || (Tracked.Priority == Priority.GetValue())) ? 1 : 0;
+	}
+
+	return Count;
+}
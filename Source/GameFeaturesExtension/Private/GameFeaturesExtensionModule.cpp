@@ -1,5 +1,15 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
+#include "GameFeaturesExtensionStats.h"
 #include "Modules/ModuleManager.h"
-	
-IMPLEMENT_MODULE(FDefaultModuleImpl, GameFeaturesExtension)
\ No newline at end of file
+
+DEFINE_STAT(STAT_GameFeaturesExtension_Activate);
+DEFINE_STAT(STAT_GameFeaturesExtension_Deactivate);
+DEFINE_STAT(STAT_GameFeaturesExtension_AddToWorld);
+DEFINE_STAT(STAT_GameFeaturesExtension_LiveContextEntries);
+
+LLM_DEFINE_TAG(GameFeaturesExtension);
+
+UE_TRACE_CHANNEL_DEFINE(GameFeaturesExtensionChannel);
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, GameFeaturesExtension)
@@ -0,0 +1,71 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+class FDataValidationContext;
+class UGameFeatureAction;
+class UObject;
+enum class EDataValidationResult : uint8;
+
+/** Static cost of the assets a single action pulls in when its feature loads */
+struct FGameFeatureActionCost
+{
+	/** Path name of the action */
+	FString ActionName;
+
+	/** Assets referenced by the action itself, by class name */
+	TMap<FName, int32> AssetCountsByClass;
+
+	/** Packages loaded along with the action, including hard dependencies of its assets */
+	TSet<FName> Packages;
+
+	/** Summed size of Packages on disk */
+	int64 DiskBytes = 0;
+
+	/** Rough resident size of Packages, see GameFeaturesExtension.Cost.MemoryToDiskRatio */
+	int64 EstimatedMemoryBytes = 0;
+};
+
+/** Static cost of all actions of a feature. Packages shared between actions only count once in the totals. */
+struct FGameFeatureCostReport
+{
+	TArray<FGameFeatureActionCost> Actions;
+
+	int32 NumPackages = 0;
+	int64 DiskBytes = 0;
+	int64 EstimatedMemoryBytes = 0;
+};
+
+/**
+ * Estimates what activating a feature costs before playing, from the asset registry only, so nothing has to be loaded.
+ * Referenced assets are found through reflection on the action (object and soft object properties, including nested
+ * structs and containers) and through its asset bundle data, then resolved transitively along hard package dependencies.
+ * Budgets are configured with the GameFeaturesExtension.Cost.* console variables, e.g. from DefaultEngine.ini.
+ */
+class FGameFeatureActionCostEstimator
+{
+public:
+	/** Returns the cost of a single action */
+	static GAMEFEATURESEXTENSION_API FGameFeatureActionCost EstimateAction(const UGameFeatureAction& Action);
+
+	/** Returns the cost of the given actions, e.g. all actions of a game feature data or action set */
+	static GAMEFEATURESEXTENSION_API FGameFeatureCostReport EstimateActions(TConstArrayView<const UGameFeatureAction*> Actions);
+
+	/** Returns the actions of a game feature data or action set, or an empty array for any other asset */
+	static GAMEFEATURESEXTENSION_API TArray<const UGameFeatureAction*> GetFeatureActions(const UObject& FeatureAsset);
+
+	/** Adds a warning for every action budget the cost exceeds. Returns false if a budget was exceeded. */
+	static GAMEFEATURESEXTENSION_API bool CheckActionBudgets(const FGameFeatureActionCost& Cost, FDataValidationContext& Context);
+
+	/** Adds a warning for every feature budget the report exceeds. Returns false if a budget was exceeded. */
+	static GAMEFEATURESEXTENSION_API bool CheckFeatureBudgets(const FGameFeatureCostReport& Report, FDataValidationContext& Context);
+
+	/** Returns the data validation result budget overruns should produce, Invalid only if GameFeaturesExtension.Cost.OverBudgetIsError is set */
+	static GAMEFEATURESEXTENSION_API EDataValidationResult GetOverBudgetResult();
+};
+
+#endif // WITH_EDITOR
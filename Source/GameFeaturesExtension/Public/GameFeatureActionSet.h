@@ -11,6 +11,7 @@ class UGameFeatureAction;
 /**
  * Defines a set of GameFeatureActions.
  * Useful for grouping actions together and re-using them in multiple places. 
+ * Sets can include other sets, use GetAllActions to get the flattened list of every action to run.
  */
 UCLASS(MinimalAPI, BlueprintType, Blueprintable)
 class UGameFeatureActionSet : public UPrimaryDataAsset
@@ -21,9 +22,12 @@ public:
 	UGameFeatureActionSet();
 
 	//~ Begin UObject Interface
+	virtual void PostLoad() override;
 #if WITH_EDITOR
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+	virtual void PreSave(FObjectPreSaveContext ObjectSaveContext) override;
 	virtual void PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 	//~ End UObject Interface
 
@@ -38,11 +42,49 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Dependencies")
 	TArray<FGameFeaturePluginURL> GameFeaturesToEnable;
 
-	/** List of Game Feature Actions to perform as this action set is loaded/activated/deactivated/unloaded */
+	/**
+	 * List of Game Feature Actions to perform as this action set is loaded/activated/deactivated/unloaded.
+	 * Only holds the actions authored in this set, consumers running actions should use GetAllActions or ForEachAction instead,
+	 * which include the actions of included sets.
+	 */
 	UPROPERTY(EditDefaultsOnly, Instanced, Category = "Actions")
 	TArray<TObjectPtr<UGameFeatureAction>> Actions;
 
+	/** Other action sets whose actions run before the actions of this set */
+	UPROPERTY(EditDefaultsOnly, Category = "Actions")
+	TArray<TObjectPtr<UGameFeatureActionSet>> IncludedActionSets;
+
+	/**
+	 * Returns the actions of this set and every set it includes, included sets first.
+	 * Actions that are identical to an earlier one (same class and properties) are only listed once, so they only run once.
+	 * This only deduplicates execution, every set still stores and loads its own instances of the actions it authored.
+	 */
+	GAMEFEATURESEXTENSION_API const TArray<TObjectPtr<UGameFeatureAction>>& GetAllActions() const;
+
+	/**
+	 * Rebuilds the list returned by GetAllActions from this set and its included sets. Returns false if the includes contain a cycle.
+	 * Done automatically when loading, editing and saving, sets changed at runtime have to call it themselves.
+	 */
+	GAMEFEATURESEXTENSION_API bool RebuildAllActions();
+
+	/** Calls Func for every valid action returned by GetAllActions */
+	template <typename FuncType>
+	void ForEachAction(FuncType&& Func) const
+	{
+		for (UGameFeatureAction* Action : GetAllActions())
+		{
+			if (Action)
+			{
+				Func(*Action);
+			}
+		}
+	}
+
 private:
+	/** Included sets flattened in dependency order with duplicates removed, built at cook and stored with the cooked asset */
+	UPROPERTY()
+	TArray<TObjectPtr<UGameFeatureAction>> AllActions;
+
 	UPROPERTY(AssetRegistrySearchable)
 	uint32 FeatureDependencies;
 };
@@ -12,6 +12,7 @@ class UInputMappingContext;
 class UPlayer;
 class APlayerController;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 
 /**
  * Represents a context in which input mappings are active.
@@ -22,7 +23,7 @@ struct FInputMappingContextAndPriority
 	GENERATED_BODY()
 
 	/** The mapping context to register with the player's EnhancedInput system. */
-	UPROPERTY(EditAnywhere, Category = "Input", meta = (AssetBundles = "Client,Server"))
+	UPROPERTY(EditAnywhere, Category = "Input", meta = (AssetBundles = "Client"))
 	TSoftObjectPtr<UInputMappingContext> InputMapping;
 
 	/** Higher-priority contexts will take precedence over lower-priority contexts. */
@@ -46,13 +47,14 @@ class UGameFeatureAction_AddInputMappingContext : public UGameFeatureAction_Worl
 public:
 	//~ Begin UGameFeatureAction Interface
 	virtual void OnGameFeatureRegistering() override;
-	virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
 	virtual void OnGameFeatureUnregistering() override;
 	//~ End UGameFeatureAction Interface
 
 	//~ Begin UGameFeatureAction_WorldActionBase Interface
+	virtual EGameFeatureActionNetExecution GetNetExecution() const override;
+	virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
 	//~ End UGameFeatureAction_WorldActionBase Interface
 
 	//~ Begin UObject Interface
@@ -67,16 +69,29 @@ private:
 	TArray<FInputMappingContextAndPriority> InputMappings;
 
 private:
-	struct FPerContextData
+	struct FPerContextData : public FGameFeatureWorldActionContextState
 	{
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
 		TArray<TSharedPtr<FComponentRequestHandle>> ExtensionRequestHandles;
 		TArray<TWeakObjectPtr<APlayerController>> ControllersAddedTo;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Loads=%d Requests=%d Controllers=%d"), LoadHandles.Num(), ExtensionRequestHandles.Num(), ControllersAddedTo.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return LoadHandles.GetAllocatedSize() + ExtensionRequestHandles.GetAllocatedSize() + ControllersAddedTo.GetAllocatedSize();
+		}
 	};
-	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
 
 	/** Delegate for when the game instance is changed to register IMC's */
 	FDelegateHandle RegisterInputContextMappingsForGameInstanceHandle;
 
+	/** Loads of mapping contexts to register with the settings, cancelled when unregistering */
+	TArray<TSharedPtr<FStreamableHandle>> SettingsLoadHandles;
+
 	/** Registers owned Input Mapping Contexts to the Input Registry Subsystem. Also binds onto the start of GameInstances and the adding/removal of Local Players. */
 	void RegisterInputMappingContexts();
 	
@@ -86,6 +101,9 @@ private:
 	/** Registers owned Input Mapping Contexts to the Input Registry Subsystem for a specified Local Player. This also gets called when a Local Player is added. */
 	void RegisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer);
 
+	/** Registers the owned Input Mapping Contexts that are loaded with the settings of a Local Player, once loading them finished */
+	void RegisterLoadedInputMappingContextsForLocalPlayer(TWeakObjectPtr<ULocalPlayer> WeakLocalPlayer);
+
 	/** Unregisters owned Input Mapping Contexts from the Input Registry Subsystem. Also unbinds from the start of GameInstances and the adding/removal of Local Players. */
 	void UnregisterInputMappingContexts();
 
@@ -95,7 +113,11 @@ private:
 	/** Unregisters owned Input Mapping Contexts from the Input Registry Subsystem for a specified Local Player. This also gets called when a Local Player is removed. */
 	void UnregisterInputMappingContextsForLocalPlayer(ULocalPlayer* LocalPlayer);
 
+	/** Appends the mapping contexts that still have to be loaded, only those registered with the settings if bSettingsOnly */
+	void GatherMappingsToLoad(bool bSettingsOnly, TArray<FSoftObjectPath>& OutMappings) const;
+
 	void Reset(FPerContextData& ActiveData);
+	void HandleMappingsLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext);
 	void HandleControllerExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext);
 	void AddInputMappingForPlayer(UPlayer* Player, FPerContextData& ActiveData);
 	void RemoveInputMapping(APlayerController* PlayerController, FPerContextData& ActiveData);
@@ -0,0 +1,134 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Engine/EngineTypes.h"
+#include "GameFeatureAction_WorldActionBase.h"
+#include "Math/Transform.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "GameFeatureAction_AddInstancedMeshes.generated.h"
+
+class AActor;
+class FText;
+class UObject;
+class UStaticMesh;
+class UWorld;
+struct FAssetBundleData;
+struct FStreamableHandle;
+struct FWorldContext;
+
+/** A static mesh and all the transforms it should be instanced at. */
+USTRUCT()
+struct FGameFeatureInstancedMeshEntry
+{
+	GENERATED_BODY()
+
+	// The mesh to instance
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	TSoftObjectPtr<UStaticMesh> Mesh;
+
+	// World space transforms of every instance
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	TArray<FTransform> InstanceTransforms;
+
+	// Use a hierarchical instanced component, which culls and LODs per cluster. Best for large instance counts.
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	bool bUseHierarchicalInstancing = true;
+
+	// Collision of the instances. Entries without collision are skipped on dedicated servers.
+	UPROPERTY(EditAnywhere, Category = "Mesh")
+	TEnumAsByte<ECollisionEnabled::Type> CollisionEnabled = ECollisionEnabled::NoCollision;
+
+	// Distance at which instances start fading out, 0 disables culling
+	UPROPERTY(EditAnywhere, Category = "Mesh|Culling", meta = (ClampMin = "0", Units = "cm"))
+	int32 InstanceStartCullDistance = 0;
+
+	// Distance at which instances are fully culled, 0 disables culling
+	UPROPERTY(EditAnywhere, Category = "Mesh|Culling", meta = (ClampMin = "0", Units = "cm"))
+	int32 InstanceEndCullDistance = 0;
+};
+
+/** Record for the game feature data. Specifies which meshes to instance for target worlds. */
+USTRUCT()
+struct FGameFeatureInstancedMeshWorldEntry
+{
+	GENERATED_BODY()
+
+	// The world to instance the meshes in (can be left blank, in which case we'll instance them in all worlds)
+	UPROPERTY(EditAnywhere, Category = "Feature Data")
+	TSoftObjectPtr<UWorld> TargetWorld;
+
+	// The meshes to instance
+	UPROPERTY(EditAnywhere, Category = "Feature Data", meta = (TitleProperty = "Mesh"))
+	TArray<FGameFeatureInstancedMeshEntry> Meshes;
+};
+
+/**
+ * GameFeature action which adds instanced static meshes to particular levels at runtime.
+ * A lightweight alternative to Add Spawned Actors for props and decoration: every world gets a single actor
+ * holding one instanced component per mesh and settings, no matter how many transforms are listed.
+ */
+UCLASS(MinimalAPI, meta = (DisplayName = "Add Instanced Meshes"))
+class UGameFeatureAction_AddInstancedMeshes final : public UGameFeatureAction_WorldActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UGameFeatureAction interface
+#if WITH_EDITORONLY_DATA
+	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
+#endif
+	//~ End UGameFeatureAction interface
+
+	//~ Begin UObject interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+	//~ End UObject interface
+
+	UPROPERTY(EditAnywhere, Category = "Instanced Meshes")
+	TArray<FGameFeatureInstancedMeshWorldEntry> InstancedMeshesList;
+
+private:
+	//~ Begin UGameFeatureAction_WorldActionBase interface
+	virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual bool SupportsIncrementalTeardown() const override;
+	virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	//~ End UGameFeatureAction_WorldActionBase interface
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+
+		/** One holder actor per world the meshes were added to */
+		TArray<TWeakObjectPtr<AActor>> HolderActors;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Loads=%d Holders=%d"), LoadHandles.Num(), HolderActors.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return LoadHandles.GetAllocatedSize() + HolderActors.GetAllocatedSize();
+		}
+	};
+
+	/** Appends the mesh entries that should be added to World */
+	void GatherMeshEntriesForWorld(UWorld& World, TArray<const FGameFeatureInstancedMeshEntry*>& OutEntries) const;
+
+	void HandleMeshesLoaded(TWeakObjectPtr<UWorld> WeakWorld, FGameFeatureStateChangeContext ChangeContext);
+
+	/** Spawns the holder actor with a component per mesh and settings, entries whose mesh failed to load are skipped */
+	void AddMeshesToWorld(UWorld& World, FPerContextData& ActiveData);
+
+	static void CancelLoads(FPerContextData& ActiveData);
+};
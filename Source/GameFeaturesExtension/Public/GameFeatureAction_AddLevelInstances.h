@@ -55,11 +55,6 @@ class UGameFeatureAction_AddLevelInstances final : public UGameFeatureAction_Wor
 	GENERATED_BODY()
 
 public:
-	//~ Begin UGameFeatureAction interface
-	virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
-	//~ End UGameFeatureAction interface
-
 	//~ Begin UObject interface
 #if WITH_EDITOR
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
@@ -73,22 +68,48 @@ public:
 private:
 	//~ Begin UGameFeatureAction_WorldActionBase interface
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual bool SupportsIncrementalTeardown() const override;
+	virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext) override;
 	//~ End UGameFeatureAction_WorldActionBase interface
 
-	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
-	
-	ULevelStreamingDynamic* LoadDynamicLevelForEntry(const FGameFeatureLevelInstanceEntry& Entry, UWorld* TargetWorld);	
+	struct FAddedLevel
+	{
+		TObjectPtr<ULevelStreamingDynamic> Level;
+
+		/** Hash of the entry the level was loaded for */
+		uint32 EntryHash = 0;
+	};
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<FAddedLevel> AddedLevels;
+
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Levels=%d"), AddedLevels.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return AddedLevels.GetAllocatedSize();
+		}
+	};
+
+	/** Gathers the entries to load in the given world */
+	void GatherEntriesForWorld(UWorld& World, TArray<const FGameFeatureLevelInstanceEntry*>& OutEntries) const;
+
+	ULevelStreamingDynamic* LoadDynamicLevelForEntry(const FGameFeatureLevelInstanceEntry& Entry, uint32 EntryHash, UWorld* TargetWorld, FPerContextData& ActiveData);
 
 	UFUNCTION() // UFunction so we can bind to a dynamic delegate
 	void OnLevelLoaded();
 
-	void DestroyAddedLevels();
 	void CleanUpAddedLevel(ULevelStreamingDynamic* Level);
 
 private:
-	UPROPERTY(transient)
-	TArray<TObjectPtr<ULevelStreamingDynamic>> AddedLevels;
-
-	bool bIsActivated = false;
 	bool bLayerStateReentrantGuard = false;
 };
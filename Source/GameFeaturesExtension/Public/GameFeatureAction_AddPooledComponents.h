@@ -0,0 +1,170 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Containers/Ticker.h"
+#include "GameFeatureAction_WorldActionBase.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/Interface.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "GameFeatureAction_AddPooledComponents.generated.h"
+
+class AActor;
+class UActorComponent;
+class UGameInstance;
+struct FComponentRequestHandle;
+struct FStreamableHandle;
+struct FWorldContext;
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UGameFeaturePoolableComponent : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Opts a component class into pooling by UGameFeatureAction_AddPooledComponents, components of other classes are destroyed when removed.
+ * A pooled component is handed to a different actor next, so it must not carry anything over from its previous owner.
+ */
+class IGameFeaturePoolableComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called once the component was removed from its owner, before it is put in the pool.
+	 * Reset all gameplay state set up since construction, e.g. cached references, timers, bound delegates or counters.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Game Features")
+	void ResetForPool();
+};
+
+/** Description of a component to add to a type of actor when this game feature is enabled. */
+USTRUCT()
+struct FGameFeaturePooledComponentEntry
+{
+	GENERATED_BODY()
+
+	// The base actor class to add a component to
+	UPROPERTY(EditAnywhere, Category = "Components", meta = (AllowAbstract = "True"))
+	TSoftClassPtr<AActor> ActorClass;
+
+	// The component class to add to the specified type of actor
+	UPROPERTY(EditAnywhere, Category = "Components")
+	TSoftClassPtr<UActorComponent> ComponentClass;
+
+	// Should this component be added for clients
+	UPROPERTY(EditAnywhere, Category = "Components")
+	uint8 bClientComponent : 1 = true;
+
+	// Should this component be added on servers
+	UPROPERTY(EditAnywhere, Category = "Components")
+	uint8 bServerComponent : 1 = true;
+};
+
+/** Unregistered components of a single class, waiting to be handed to the next receiver. */
+USTRUCT()
+struct FGameFeatureComponentPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UActorComponent>> Components;
+};
+
+/**
+ * GameFeature action which adds components to actors through the UGameFrameworkComponentManager.
+ * Unlike the engine's Add Components action, component classes are loaded asynchronously, registration is spread
+ * over several frames and removed components are pooled, so toggling a feature or churning receivers reuses instances
+ * instead of constructing and destroying them.
+ * Only component classes implementing IGameFeaturePoolableComponent are pooled, see ResetForPool.
+ */
+UCLASS(MinimalAPI, meta = (DisplayName = "Add Pooled Components"))
+class UGameFeatureAction_AddPooledComponents final : public UGameFeatureAction_WorldActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UGameFeatureAction interface
+	virtual void OnGameFeatureUnloading() override;
+#if WITH_EDITORONLY_DATA
+	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
+#endif
+	//~ End UGameFeatureAction interface
+
+	//~ Begin UObject interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+	//~ End UObject interface
+
+	/** List of components to add to gameplay actors when this game feature is enabled */
+	UPROPERTY(EditAnywhere, Category = "Components", meta = (TitleProperty = "{ActorClass} -> {ComponentClass}"))
+	TArray<FGameFeaturePooledComponentEntry> ComponentList;
+
+private:
+	//~ Begin UGameFeatureAction_WorldActionBase interface
+	virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void DescribeRuntime(FStringBuilderBase& Out) const override;
+	//~ End UGameFeatureAction_WorldActionBase interface
+
+	struct FPendingRegistration
+	{
+		TWeakObjectPtr<AActor> Actor;
+		int32 EntryIndex = INDEX_NONE;
+	};
+
+	struct FAddedComponent
+	{
+		TWeakObjectPtr<UActorComponent> Component;
+		int32 EntryIndex = INDEX_NONE;
+	};
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
+		TArray<FPendingRegistration> PendingRegistrations;
+		TMap<FObjectKey, TArray<FAddedComponent>> ActorComponents;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Loads=%d Requests=%d Pending=%d Actors=%d"), LoadHandles.Num(), ComponentRequests.Num(), PendingRegistrations.Num(), ActorComponents.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			SIZE_T Size = LoadHandles.GetAllocatedSize() + ComponentRequests.GetAllocatedSize() + PendingRegistrations.GetAllocatedSize() + ActorComponents.GetAllocatedSize();
+			for (const TPair<FObjectKey, TArray<FAddedComponent>>& Pair : ActorComponents)
+			{
+				Size += Pair.Value.GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
+
+	void HandleComponentClassesLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext);
+	void HandleActorExtension(AActor* Actor, FName EventName, int32 EntryIndex, FGameFeatureStateChangeContext ChangeContext);
+	bool ProcessPendingRegistrations(float DeltaTime);
+
+	void AddComponent(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
+	void RemoveComponents(AActor* Actor, int32 EntryIndex, FPerContextData& ActiveData);
+
+	UActorComponent* AcquireComponent(UClass* ComponentClass, AActor* Owner);
+	void ReleaseComponent(UActorComponent* Component);
+
+	/** Removed components, kept across receivers and activations until the feature unloads */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FGameFeatureComponentPool> ComponentPools;
+
+	/** Bound only while registrations are pending */
+	FTSTicker::FDelegateHandle RegistrationTickerHandle;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Containers/Array.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/EngineTypes.h"
 #include "GameFeatureAction_WorldActionBase.h"
 #include "Math/Transform.h"
 #include "Misc/CoreMiscDefines.h"
@@ -21,6 +23,23 @@ struct FAssetBundleData;
 struct FGameFeatureDeactivatingContext;
 struct FWorldContext;
 
+/** Controls on which processes a feature spawned actor exists and whether it replicates. */
+UENUM()
+enum class ESpawnedActorNetPolicy : uint8
+{
+	// Spawn in every game world and keep the replication settings of the actor class
+	Default,
+
+	// Only spawn where we have authority (server or standalone), never replicated
+	ServerOnly,
+
+	// Spawn locally on every process that isn't a dedicated server, never replicated
+	ClientLocal,
+
+	// Only spawn where we have authority and replicate to clients
+	AuthorityReplicated,
+};
+
 /** Record for the an actor to spawn along with a game feature data. */
 USTRUCT()
 struct FSpawningActorEntry
@@ -34,6 +53,37 @@ struct FSpawningActorEntry
 	// Where to spawn the actor
 	UPROPERTY(EditAnywhere, Category = "Actor|Transform")
 	FTransform SpawnTransform;
+
+	// On which processes to spawn the actor and whether it replicates
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking")
+	ESpawnedActorNetPolicy NetPolicy = ESpawnedActorNetPolicy::Default;
+
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (InlineEditConditionToggle))
+	uint8 bOverrideNetDormancy : 1 = false;
+
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (InlineEditConditionToggle))
+	uint8 bOverrideNetUpdateFrequency : 1 = false;
+
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (InlineEditConditionToggle))
+	uint8 bOverrideNetCullDistance : 1 = false;
+
+	// Dormancy the actor starts with, initially dormant actors don't cost any bandwidth until woken up
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (EditCondition = "bOverrideNetDormancy"))
+	TEnumAsByte<ENetDormancy> NetDormancy = DORM_Initial;
+
+	// How often (per second) the actor is considered for replication
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (EditCondition = "bOverrideNetUpdateFrequency", ClampMin = "0.1"))
+	float NetUpdateFrequency = 10.f;
+
+	// Distance beyond which the actor stops being relevant to clients
+	UPROPERTY(EditAnywhere, Category = "Actor|Networking", meta = (EditCondition = "bOverrideNetCullDistance", ClampMin = "0", Units = "cm"))
+	float NetCullDistance = 15000.f;
+
+	/** Returns true if this entry should be spawned in a world with the given net mode */
+	bool ShouldSpawnForNetMode(ENetMode NetMode) const;
+
+	/** Applies the networking overrides of this entry to a deferred spawned actor, before it finishes spawning */
+	void ApplyNetSettings(AActor& Actor) const;
 };
 
 /** Record for the game feature data. Specifies which actors to spawn for target worlds. */
@@ -61,7 +111,6 @@ class UGameFeatureAction_AddSpawnedActors final : public UGameFeatureAction_Worl
 
 public:
 	//~ Begin UGameFeatureAction interface
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
 #if WITH_EDITORONLY_DATA
 	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
 #endif
@@ -79,9 +128,38 @@ public:
 private:
 	//~ Begin UGameFeatureAction_WorldActionBase interface
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual bool SupportsIncrementalTeardown() const override;
+	virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext) override;
 	//~ End UGameFeatureAction_WorldActionBase interface
 
-	void Reset();
+	struct FSpawnedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Hash of the entry the actor was spawned from */
+		uint32 EntryHash = 0;
+	};
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<FSpawnedActor> SpawnedActors;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Actors=%d"), SpawnedActors.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return SpawnedActors.GetAllocatedSize();
+		}
+	};
+
+	/** Gathers the entries to spawn in the given world */
+	void GatherEntriesForWorld(UWorld& World, TArray<const FSpawningActorEntry*>& OutEntries) const;
 
-	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+	void SpawnEntry(UWorld& World, const FSpawningActorEntry& ActorEntry, uint32 EntryHash, FPerContextData& ActiveData);
 };
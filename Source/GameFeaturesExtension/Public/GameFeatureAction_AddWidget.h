@@ -10,8 +10,11 @@
 #include "GameFeatureAction_AddWidget.generated.h"
 
 class UCommonActivatableWidget;
+class UCommonLocalPlayer;
+class UGameInstance;
 struct FWorldContext;
 struct FComponentRequestHandle;
+struct FStreamableHandle;
 
 /**
  * Request to add a layout widget to the player's viewport.
@@ -63,13 +66,15 @@ class UGameFeatureAction_AddWidget : public UGameFeatureAction_WorldActionBase
 
 public:
 	//~ Begin UGameFeatureAction Interface
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
-
 #if WITH_EDITORONLY_DATA
 	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
 #endif
 	//~ End UGameFeatureAction Interface
 
+	//~ Begin UGameFeatureAction_WorldActionBase Interface
+	virtual EGameFeatureActionNetExecution GetNetExecution() const override;
+	//~ End UGameFeatureAction_WorldActionBase Interface
+
 	//~ Begin UObject Interface
 #if WITH_EDITOR
 	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
@@ -86,26 +91,70 @@ private:
 	TArray<FGameFeatureWidgetHUDElementRequest> Widgets;
 
 private:
+	struct FAddedLayout
+	{
+		TWeakObjectPtr<UCommonActivatableWidget> Widget;
+		uint32 EntryHash = 0;
+	};
+
+	struct FAddedHUDElement
+	{
+		FUIExtensionHandle Handle;
+		uint32 EntryHash = 0;
+	};
+
 	struct FPerActorData
 	{
-		TArray<TWeakObjectPtr<UCommonActivatableWidget>> LayoutsAdded;
-		TArray<FUIExtensionHandle> ExtensionHandles;
+		TArray<FAddedLayout> LayoutsAdded;
+		TArray<FAddedHUDElement> ExtensionHandles;
 	};
 
-	struct FPerContextData
+	struct FPerContextData : public FGameFeatureWorldActionContextState
 	{
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
 		TArray<TSharedPtr<FComponentRequestHandle>> ComponentRequests;
 		TMap<FObjectKey, FPerActorData> ActorData;
-	};
 
-	TMap<FGameFeatureStateChangeContext, FPerContextData> ContextData;
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Loads=%d Requests=%d Actors=%d"), LoadHandles.Num(), ComponentRequests.Num(), ActorData.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			SIZE_T Size = LoadHandles.GetAllocatedSize() + ComponentRequests.GetAllocatedSize() + ActorData.GetAllocatedSize();
+			for (const TPair<FObjectKey, FPerActorData>& Pair : ActorData)
+			{
+				Size += Pair.Value.LayoutsAdded.GetAllocatedSize() + Pair.Value.ExtensionHandles.GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
 
 	//~ Begin UGameFeatureAction_WorldActionBase Interface
+	virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const override;
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext) override;
 	//~ End UGameFeatureAction_WorldActionBase Interface
 
+	/** Appends the layout and widget classes that still have to be loaded */
+	void GatherClassesToLoad(TArray<FSoftObjectPath>& OutClasses) const;
+
+	/** Requests the classes that still have to be loaded, calls OnLoaded right away when there are none */
+	void LoadClasses(FPerContextData& ActiveData, FStreamableDelegate&& OnLoaded);
+
 	void Reset(FPerContextData& ActiveData);
+	void HandleWidgetClassesLoaded(TWeakObjectPtr<UGameInstance> WeakGameInstance, FGameFeatureStateChangeContext ChangeContext);
+	void HandleReconcileClassesLoaded(FGameFeatureStateChangeContext ChangeContext);
 	void HandleActorExtension(AActor* Actor, FName EventName, FGameFeatureStateChangeContext ChangeContext);
 	void AddWidgets(AActor* Actor, FPerContextData& ActiveData);
 	void RemoveWidgets(AActor* Actor, FPerContextData& ActiveData);
+	void ReconcileWidgets(AActor* Actor, FPerActorData& ActorData);
+
+	/** Returns the local player widgets should be added for, or nullptr if the HUD shouldn't receive any */
+	static UCommonLocalPlayer* GetLocalPlayerForHUD(const AActor* Actor);
+
+	void AddLayout(UCommonLocalPlayer* LocalPlayer, const FGameFeatureWidgetLayoutRequest& Entry, uint32 EntryHash, FPerActorData& ActorData);
+	void AddHUDElement(UCommonLocalPlayer* LocalPlayer, const FGameFeatureWidgetHUDElementRequest& Entry, uint32 EntryHash, FPerActorData& ActorData);
 };
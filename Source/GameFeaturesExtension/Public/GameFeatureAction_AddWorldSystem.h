@@ -12,6 +12,7 @@
 #include "UObject/Object.h"
 #include "UObject/SoftObjectPtr.h"
 #include "UObject/UObjectGlobals.h"
+#include "UObject/WeakObjectPtrTemplates.h"
 
 #include "GameFeatureAction_AddWorldSystem.generated.h"
 
@@ -63,7 +64,6 @@ class UGameFeatureAction_AddWorldSystem : public UGameFeatureAction_WorldActionB
 
 public:
 	//~ Begin UGameFeatureAction interface
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
 #if WITH_EDITORONLY_DATA
 	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
 #endif
@@ -84,9 +84,40 @@ public:
 private:
 	//~ Begin UGameFeatureAction_WorldActionBase interface
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual bool SupportsIncrementalTeardown() const override;
+	virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext) override;
 	//~ End UGameFeatureAction_WorldActionBase interface
 
-	void Reset();
+	struct FRequestedSystem
+	{
+		TWeakObjectPtr<UWorld> World;
+		TSubclassOf<UGameFeatureWorldSystem> SystemType;
+
+		/** Hash of the entry the system was requested for */
+		uint32 EntryHash = 0;
+	};
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		/** Systems requested from each world's manager, released again when the context deactivates */
+		TArray<FRequestedSystem> RequestedSystems;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Systems=%d"), RequestedSystems.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return RequestedSystems.GetAllocatedSize();
+		}
+	};
+
+	/** Gathers the entries to request in the given world */
+	void GatherEntriesForWorld(UWorld& World, TArray<const FGameFeatureWorldSystemEntry*>& OutEntries) const;
 };
 
 
@@ -104,6 +135,10 @@ class UGameFeatureWorldSystemManager : public UWorldSubsystem
 	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override;
 	//~ End UWorldSubsystem interface
 
+public:
+	/** Live systems along with the number of outstanding requests for each */
+	const TMap<TObjectPtr<UGameFeatureWorldSystem>, int32>& GetSystemInstances() const { return SystemInstances; }
+
 private:
 	friend class UGameFeatureAction_AddWorldSystem;
 
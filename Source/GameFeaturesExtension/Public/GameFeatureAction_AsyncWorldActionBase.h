@@ -0,0 +1,199 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "GameFeatureAction_WorldActionBase.h"
+#include "GameFeatureStreamingManager.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include <coroutine>
+
+#include "GameFeatureAction_AsyncWorldActionBase.generated.h"
+
+class ULevelStreaming;
+class UWorld;
+struct FWorldContext;
+
+/**
+ * Return type of UGameFeatureAction_AsyncWorldActionBase::OnAddToWorldAsync. The coroutine starts running immediately,
+ * owns itself while suspended and is destroyed once it returns or its operation is cancelled.
+ */
+struct FGameFeatureAsyncTask
+{
+	struct promise_type
+	{
+		FGameFeatureAsyncTask get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { checkNoEntry(); }
+	};
+};
+
+/**
+ * State of a single OnAddToWorldAsync call. Awaiters park the coroutine here while they wait,
+ * cancelling drops whatever it waits on and destroys the coroutine frame without resuming it.
+ */
+class FGameFeatureAsyncOperation : public TSharedFromThis<FGameFeatureAsyncOperation>
+{
+public:
+	FGameFeatureAsyncOperation(const UObject& InOwner, UWorld* InWorld)
+		: Owner(&InOwner)
+		, World(InWorld)
+	{
+	}
+
+	/** Returns true once cancelled, or if the action or the world it was started for went away */
+	GAMEFEATURESEXTENSION_API bool IsCancelled() const;
+
+	/** Returns true while the coroutine is waiting on something */
+	bool IsSuspended() const { return bool(Suspended); }
+
+	/** Cancels what the coroutine waits on and destroys it. Locals of the coroutine are destroyed as if it returned. */
+	GAMEFEATURESEXTENSION_API void Cancel();
+
+	/** Parks the coroutine until Resume is called. OnCancel is called instead if the operation is cancelled first. */
+	GAMEFEATURESEXTENSION_API void Suspend(std::coroutine_handle<> Handle, TFunction<void()>&& OnCancel);
+
+	/** Continues the parked coroutine, or destroys it if the operation was cancelled in the meantime */
+	GAMEFEATURESEXTENSION_API void Resume();
+
+	UWorld* GetWorld() const { return World.Get(); }
+
+private:
+	TWeakObjectPtr<const UObject> Owner;
+	TWeakObjectPtr<UWorld> World;
+	std::coroutine_handle<> Suspended;
+	TFunction<void()> CancelPending;
+	bool bCancelled = false;
+};
+
+/**
+ * Handed to OnAddToWorldAsync, provides the world and context it was started for and the things it can wait on:
+ *
+ *	FGameFeatureAsyncTask UMyAction::OnAddToWorldAsync(FGameFeatureAsyncContext Async)
+ *	{
+ *		TSharedPtr<FStreamableHandle> Assets = co_await Async.WaitForAssets({ ActorClass.ToSoftObjectPath() });
+ *		co_await Async.NextFrame();
+ *		FindOrAddContextState<FPerContextData>(Async.GetChangeContext()).Actors.Add(Async.GetWorld()->SpawnActor(...));
+ *	}
+ *
+ * Execution only continues past a co_await if the operation is still running, so nothing has to be checked after waiting.
+ * The context is copied into the coroutine frame, don't keep references to FWorldContext or other data owned by the caller.
+ */
+class FGameFeatureAsyncContext
+{
+public:
+	FGameFeatureAsyncContext(const TSharedRef<FGameFeatureAsyncOperation>& InOperation, const FGameFeatureStateChangeContext& InChangeContext)
+		: Operation(InOperation)
+		, ChangeContext(InChangeContext)
+	{
+	}
+
+	/** Returns the world the operation was started for */
+	UWorld* GetWorld() const { return Operation->GetWorld(); }
+
+	/** Returns the context the operation was started for */
+	const FGameFeatureStateChangeContext& GetChangeContext() const { return ChangeContext; }
+
+	/**
+	 * Awaits asynchronous loading of the given assets through FGameFeatureStreamingManager.
+	 * Resumes with the streamable handle, which keeps the assets loaded for as long as it is held.
+	 */
+	struct FAssetsAwaiter
+	{
+		TSharedRef<FGameFeatureAsyncOperation> Operation;
+		TArray<FSoftObjectPath> Assets;
+		EGameFeatureStreamingPriority Priority;
+		TSharedPtr<FStreamableHandle> Handle;
+
+		GAMEFEATURESEXTENSION_API bool await_ready() const;
+		GAMEFEATURESEXTENSION_API bool await_suspend(std::coroutine_handle<> Coroutine);
+		TSharedPtr<FStreamableHandle> await_resume() { return MoveTemp(Handle); }
+	};
+
+	FAssetsAwaiter WaitForAssets(TArray<FSoftObjectPath> Assets, EGameFeatureStreamingPriority Priority = EGameFeatureStreamingPriority::GameplayCritical) const
+	{
+		return FAssetsAwaiter{ Operation, MoveTemp(Assets), Priority };
+	}
+
+	/** Awaits a streaming level becoming visible. Resumes with false if the streaming level went away first. */
+	struct FLevelAwaiter
+	{
+		TSharedRef<FGameFeatureAsyncOperation> Operation;
+		TWeakObjectPtr<ULevelStreaming> LevelStreaming;
+
+		GAMEFEATURESEXTENSION_API bool await_ready() const;
+		GAMEFEATURESEXTENSION_API void await_suspend(std::coroutine_handle<> Coroutine);
+		GAMEFEATURESEXTENSION_API bool await_resume() const;
+	};
+
+	FLevelAwaiter WaitForLevel(ULevelStreaming* LevelStreaming) const
+	{
+		return FLevelAwaiter{ Operation, LevelStreaming };
+	}
+
+	/** Awaits the given time passing, or the next frame when zero */
+	struct FDelayAwaiter
+	{
+		TSharedRef<FGameFeatureAsyncOperation> Operation;
+		float Seconds = 0.f;
+
+		bool await_ready() const { return false; }
+		GAMEFEATURESEXTENSION_API void await_suspend(std::coroutine_handle<> Coroutine);
+		void await_resume() const {}
+	};
+
+	FDelayAwaiter Delay(float Seconds) const
+	{
+		return FDelayAwaiter{ Operation, Seconds };
+	}
+
+	FDelayAwaiter NextFrame() const
+	{
+		return FDelayAwaiter{ Operation, 0.f };
+	}
+
+private:
+	TSharedRef<FGameFeatureAsyncOperation> Operation;
+	FGameFeatureStateChangeContext ChangeContext;
+};
+
+/**
+ * Base class for world actions applying themselves over several frames.
+ * Subclasses implement OnAddToWorldAsync as a coroutine awaiting asset loads, level streaming and frame yields,
+ * which is cancelled automatically when its context deactivates or is reconciled, or when its world is torn down.
+ * Whatever the coroutine applied should be kept in a context state (see FindOrAddContextState) and undone in ResetContextState as usual.
+ * Everything runs on the game thread, the coroutine is only ever resumed from the core ticker or streamable manager callbacks.
+ */
+UCLASS(Abstract, MinimalAPI)
+class UGameFeatureAction_AsyncWorldActionBase : public UGameFeatureAction_WorldActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UGameFeatureAction interface
+	GAMEFEATURESEXTENSION_API virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
+	//~ End UGameFeatureAction interface
+
+	/** Returns the number of OnAddToWorldAsync calls that are still waiting on something */
+	GAMEFEATURESEXTENSION_API int32 GetNumPendingAsyncOperations() const;
+
+protected:
+	//~ Begin UGameFeatureAction_WorldActionBase interface
+	GAMEFEATURESEXTENSION_API virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override final;
+	GAMEFEATURESEXTENSION_API virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext) override;
+	GAMEFEATURESEXTENSION_API virtual void DescribeRuntime(FStringBuilderBase& Out) const override;
+	//~ End UGameFeatureAction_WorldActionBase interface
+
+	/** Subclasses should override this to add their world-specific functionality, see FGameFeatureAsyncContext */
+	GAMEFEATURESEXTENSION_API virtual FGameFeatureAsyncTask OnAddToWorldAsync(FGameFeatureAsyncContext Async)
+		PURE_VIRTUAL(UGameFeatureAction_AsyncWorldActionBase::OnAddToWorldAsync, return {};);
+
+	/** Cancels every operation started for the given context */
+	GAMEFEATURESEXTENSION_API void CancelAsyncOperations(const FGameFeatureStateChangeContext& ChangeContext);
+
+private:
+	TMap<FGameFeatureStateChangeContext, TArray<TWeakPtr<FGameFeatureAsyncOperation>>> AsyncOperations;
+};
@@ -0,0 +1,164 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFeatureAction_WorldActionBase.h"
+
+#include "GameFeatureAction_OverrideConsoleVariables.generated.h"
+
+class IConsoleVariable;
+
+/** Scalability groups, each driven by its sg.*Quality console variable */
+UENUM()
+enum class EGameFeatureScalabilityGroup : uint8
+{
+	ViewDistance,
+	AntiAliasing,
+	Shadow,
+	GlobalIllumination,
+	Reflection,
+	PostProcess,
+	Texture,
+	Effects,
+	Foliage,
+	Shading,
+};
+
+/** A console variable to override while the feature is active, e.g. t.MaxFPS or net.MaxNetTickRate */
+USTRUCT()
+struct FGameFeatureConsoleVariableOverride
+{
+	GENERATED_BODY()
+
+	/** Name of the console variable */
+	UPROPERTY(EditAnywhere, Category = "Console Variables")
+	FString Name;
+
+	/** Value to set while active */
+	UPROPERTY(EditAnywhere, Category = "Console Variables")
+	FString Value;
+
+	/** When several active features override the same variable, the highest priority wins. Ties go to the most recently activated feature. */
+	UPROPERTY(EditAnywhere, Category = "Console Variables")
+	int32 Priority = 0;
+};
+
+/** A scalability group to override while the feature is active */
+USTRUCT()
+struct FGameFeatureScalabilityOverride
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Scalability")
+	EGameFeatureScalabilityGroup Group = EGameFeatureScalabilityGroup::ViewDistance;
+
+	/** Quality level to use while active, from 0 (low) to 4 (cinematic) */
+	UPROPERTY(EditAnywhere, Category = "Scalability", meta = (ClampMin = "0", ClampMax = "4"))
+	int32 Quality = 0;
+
+	/** If true, the override is skipped when the group was already at this quality or lower before any feature overrode it */
+	UPROPERTY(EditAnywhere, Category = "Scalability")
+	bool bOnlyIfLower = true;
+
+	/** When several active features override the same group, the highest priority wins. Ties go to the most recently activated feature. */
+	UPROPERTY(EditAnywhere, Category = "Scalability")
+	int32 Priority = 0;
+};
+
+/**
+ * GameFeatureAction that overrides console variables and scalability groups while the feature is active,
+ * e.g. to lower view distance, shadows, tick or net update rates for large scale modes.
+ * Every active context casts one vote per variable, the highest priority vote is applied and the value the
+ * variable had before the first vote is restored once the last vote is withdrawn.
+ * Votes don't change the SetBy priority of a variable, anything allowed to change it before can still change it while overridden.
+ * Variables are process wide, a context votes once however many game worlds it applies to. Editor worlds never vote.
+ */
+UCLASS(MinimalAPI, meta = (DisplayName = "Override Console Variables"))
+class UGameFeatureAction_OverrideConsoleVariables final : public UGameFeatureAction_WorldActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UObject interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+	//~ End UObject interface
+
+	//~ Begin UGameFeatureAction_WorldActionBase Interface
+	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void DescribeRuntime(FStringBuilderBase& Out) const override;
+	//~ End UGameFeatureAction_WorldActionBase Interface
+
+	/** Returns the console variable driving the given scalability group */
+	static const TCHAR* GetScalabilityVariableName(EGameFeatureScalabilityGroup Group);
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Console Variables", meta = (TitleProperty = "{Name} = {Value}"))
+	TArray<FGameFeatureConsoleVariableOverride> ConsoleVariables;
+
+	/** Ignored on dedicated servers */
+	UPROPERTY(EditAnywhere, Category = "Scalability", meta = (TitleProperty = "{Group} = {Quality}"))
+	TArray<FGameFeatureScalabilityOverride> ScalabilityOverrides;
+
+private:
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		/** Variable name and id of every vote this context cast */
+		TArray<TPair<FString, uint64>> Votes;
+
+		bool bVoted = false;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("Votes=%d"), Votes.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			SIZE_T Size = Votes.GetAllocatedSize();
+			for (const TPair<FString, uint64>& Vote : Votes)
+			{
+				Size += Vote.Key.GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
+
+	struct FVote
+	{
+		uint64 Id = 0;
+		FString Value;
+		int32 Priority = 0;
+	};
+
+	struct FVariableVotes
+	{
+		/** Value before the first vote, restored once the last one is withdrawn */
+		FString PriorValue;
+
+		/** ECVF_SetBy* priority of the variable before the first vote, votes are applied and restored with it */
+		uint32 PriorSetBy = 0;
+
+		/** Value the winning vote set, used to tell whether something else changed the variable since */
+		FString AppliedValue;
+
+		/** Votes in the order they were cast */
+		TArray<FVote> Votes;
+	};
+
+	/** Casts a vote for Value, returns its id or 0 if the variable doesn't exist */
+	static uint64 AddVote(const FString& Name, const FString& Value, int32 Priority);
+	static void RemoveVote(const FString& Name, uint64 VoteId);
+
+	/** Sets the variable to the value of the winning vote */
+	static void ApplyWinningVote(IConsoleVariable& Variable, FVariableVotes& VariableVotes);
+
+	/** Sets the variable to Value while leaving it at the SetBy priority it had before any vote */
+	static void SetWithPriorSetBy(IConsoleVariable& Variable, const FString& Value, const FVariableVotes& VariableVotes);
+
+	static TMap<FString, FVariableVotes> GlobalVotes;
+	static uint64 LastVoteId;
+};
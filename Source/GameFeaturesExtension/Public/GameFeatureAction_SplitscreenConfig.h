@@ -15,12 +15,10 @@ class UGameFeatureAction_SplitscreenConfig : public UGameFeatureAction_WorldActi
 	GENERATED_BODY()
 
 public:
-	//~ Begin UGameFeatureAction Interface
-	virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
-	//~ End UGameFeatureAction Interface
-
 	//~ Begin UGameFeatureAction_WorldActionBase Interface
 	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void DescribeRuntime(FStringBuilderBase& Out) const override;
 	//~ End UGameFeatureAction_WorldActionBase Interface
 
 public:
@@ -29,6 +27,20 @@ public:
 	uint8 bDisableSplitscreen : 1 = true;
 
 private:
-	TArray<FObjectKey> LocalDisableVotes;
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<FObjectKey> LocalDisableVotes;
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			Out.Appendf(TEXT("DisableVotes=%d"), LocalDisableVotes.Num());
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			return LocalDisableVotes.GetAllocatedSize();
+		}
+	};
+
 	static TMap<FObjectKey, int32> GlobalDisableVotes;
 };
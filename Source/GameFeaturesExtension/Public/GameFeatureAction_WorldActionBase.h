@@ -4,17 +4,150 @@
 
 #include "GameFeatureAction.h"
 #include "GameFeaturesSubsystem.h"
+#include "Containers/ArrayView.h"
+#include "Misc/StringBuilder.h"
+#include "GameplayTagContainer.h"
+#include "Templates/Function.h"
+#include "Templates/UniquePtr.h"
 
 #include "GameFeatureAction_WorldActionBase.generated.h"
 
+class AGameModeBase;
 class FDelegateHandle;
+class FOutputDevice;
+class FReferenceCollector;
+class ITargetPlatform;
+class UGameFeatureAction_WorldActionBase;
 class UGameInstance;
 class UObject;
+class UScriptStruct;
+class UWorld;
 struct FGameFeatureActivatingContext;
 struct FGameFeatureDeactivatingContext;
 struct FGameFeatureStateChangeContext;
+struct FSoftObjectPath;
+struct FStreamableHandle;
 struct FWorldContext;
 
+/** Describes which kind of process a world action is meaningful on. */
+UENUM()
+enum class EGameFeatureActionNetExecution : uint8
+{
+	/** Runs on every process */
+	Any,
+
+	/** Only meaningful on processes with local players (clients, listen servers and standalone), never loaded on dedicated servers */
+	ClientOnly,
+
+	/** Only meaningful on processes with authority (dedicated/listen servers and standalone), never loaded on pure clients */
+	ServerOnly,
+};
+
+/** Net modes a world action can be restricted to. */
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGameFeatureActionNetModes : uint8
+{
+	None = 0 UMETA(Hidden),
+	Standalone = 1 << 0,
+	DedicatedServer = 1 << 1,
+	ListenServer = 1 << 2,
+	Client = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EGameFeatureActionNetModes);
+
+/** World types a world action can be restricted to. */
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EGameFeatureActionWorldTypes : uint8
+{
+	None = 0 UMETA(Hidden),
+	Game = 1 << 0,
+	PIE = 1 << 1,
+	GamePreview = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EGameFeatureActionWorldTypes);
+
+/**
+ * Declarative conditions restricting the worlds a world action applies to. Empty conditions match everything.
+ * Platform, net mode and world type conditions are compiled into a bitmask, actions are stripped from cooks for platforms they never apply to.
+ */
+USTRUCT()
+struct FGameFeatureActionConditions
+{
+	GENERATED_BODY()
+
+	// Platform or platform group names (e.g. Windows, Desktop, Mobile) to apply on. Empty applies on every platform.
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	TArray<FName> Platforms;
+
+	// Net modes to apply in. None applies in every net mode.
+	UPROPERTY(EditAnywhere, Category = "Conditions", meta = (Bitmask, BitmaskEnum = "/Script/GameFeaturesExtension.EGameFeatureActionNetModes"))
+	int32 NetModes = 0;
+
+	// World types to apply in. None applies in every world type.
+	UPROPERTY(EditAnywhere, Category = "Conditions", meta = (Bitmask, BitmaskEnum = "/Script/GameFeaturesExtension.EGameFeatureActionWorldTypes"))
+	int32 WorldTypes = 0;
+
+	// Only apply to worlds running this game mode or a subclass of it
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	TSoftClassPtr<AGameModeBase> GameModeClass;
+
+	// Only apply to worlds whose game state or world settings own tags matching this query
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	FGameplayTagQuery TagQuery;
+
+	/** Returns true if any of the given platform or platform group names are allowed */
+	bool AllowsPlatform(FName PlatformName, FName PlatformGroupName) const;
+
+	/** Returns the net mode and world type bits allowed by these conditions, in the layout of the compiled condition mask */
+	uint32 CompileMask() const;
+
+	/** Returns true if the conditions can only be evaluated against a running world */
+	bool HasRuntimeConditions() const;
+};
+
+/** Activity of the world actions of a single feature */
+struct FGameFeatureActivityStats
+{
+	int32 NumActivations = 0;
+	int32 NumDeactivations = 0;
+
+	/** FPlatformTime::Seconds() of the last activation */
+	double LastActivationTime = 0.0;
+
+	/** Time spent activating, summed over every activation and adding to worlds that start later */
+	double ActivationSeconds = 0.0;
+
+	/** Time spent deactivating, summed over every deactivation and incremental teardown */
+	double DeactivationSeconds = 0.0;
+
+	/** Change in memory used by the process summed over every activation, including adding to worlds that start later. Only sampled while GameFeaturesExtension.TrackMemoryDeltas is enabled. */
+	int64 ActivationBytes = 0;
+
+	/** Change in memory used by the process summed over every deactivation, including incremental teardown. Objects left to the garbage collector are only freed by a later collection. */
+	int64 DeactivationBytes = 0;
+};
+
+/** Broadcast after a world action recorded activity for its feature, see UGameFeatureAction_WorldActionBase::GetFeatureActivityStats */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGameFeatureActivityRecorded, const UGameFeatureAction_WorldActionBase& /*Action*/);
+
+/**
+ * Base type for the state a world action keeps for a single FGameFeatureStateChangeContext.
+ * Created on first access while the context is active and destroyed once the context deactivates.
+ */
+struct FGameFeatureWorldActionContextState
+{
+	virtual ~FGameFeatureWorldActionContextState() = default;
+
+	/** Subclasses holding UObject references must report them here, the owning action forwards them to the garbage collector. */
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) {}
+
+	/** Appends a short summary of what this state holds (e.g. "SpawnedActors=3"), used by the inspection console commands */
+	virtual void Describe(FStringBuilderBase& Out) const {}
+
+	/** Returns the heap memory owned by this state, not counting the state itself */
+	virtual SIZE_T GetAllocatedSize() const { return 0; }
+};
+
 /**
  * Base class for GameFeatureActions that affect the world in some way.
  * For example, adding input bindings, setting up player controllers, etc.
@@ -26,18 +159,230 @@ class UGameFeatureAction_WorldActionBase : public UGameFeatureAction
 
 public:
 	//~ Begin UGameFeatureAction Interface
+	GAMEFEATURESEXTENSION_API virtual void OnGameFeatureLoading() override;
+	GAMEFEATURESEXTENSION_API virtual void OnGameFeatureUnloading() override;
 	GAMEFEATURESEXTENSION_API virtual void OnGameFeatureActivating(FGameFeatureActivatingContext& Context) override;
 	GAMEFEATURESEXTENSION_API virtual void OnGameFeatureDeactivating(FGameFeatureDeactivatingContext& Context) override;
 	//~ End UGameFeatureAction Interface
 
+	//~ Begin UObject Interface
+	GAMEFEATURESEXTENSION_API virtual bool NeedsLoadForClient() const override;
+	GAMEFEATURESEXTENSION_API virtual bool NeedsLoadForServer() const override;
+	GAMEFEATURESEXTENSION_API static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	GAMEFEATURESEXTENSION_API virtual bool CanBeInCluster() const override;
+	GAMEFEATURESEXTENSION_API virtual void PostInitProperties() override;
+	GAMEFEATURESEXTENSION_API virtual void PostLoad() override;
+	GAMEFEATURESEXTENSION_API virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	GAMEFEATURESEXTENSION_API virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+	GAMEFEATURESEXTENSION_API virtual bool NeedsLoadForTargetPlatform(const ITargetPlatform* TargetPlatform) const override;
+	GAMEFEATURESEXTENSION_API virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject Interface
+
+	/** Returns which kind of process this action is meaningful on. Actions that don't apply are stripped from the respective cooked builds and never activate. */
+	GAMEFEATURESEXTENSION_API virtual EGameFeatureActionNetExecution GetNetExecution() const;
+
+	/** Returns the number of per-context bookkeeping entries this action currently holds. Should return to zero once every context has been deactivated. */
+	GAMEFEATURESEXTENSION_API virtual int32 GetNumContextEntries() const;
+
+	/** Returns the number of deactivated contexts of all world actions that are still queued for teardown or retained */
+	static GAMEFEATURESEXTENSION_API int32 GetNumDeferredContexts();
+
+	/**
+	 * Brings every active context in line with the current data of this action, e.g. after a hotfix or an edit during PIE.
+	 * Actions which can tell their entries apart only apply what changed, the others are reset and added to their worlds again.
+	 * Contexts activated again within GameFeaturesExtension.Teardown.RetainSeconds of deactivating are reconciled the same way.
+	 */
+	GAMEFEATURESEXTENSION_API void ReconcileActiveContexts();
+
+	/**
+	 * Returns the activity recorded per feature, keyed by the package owning the actions (the game feature data or action set).
+	 */
+	static GAMEFEATURESEXTENSION_API const TMap<FName, FGameFeatureActivityStats>& GetFeatureActivityStats();
+
+	/** Clears every recorded activity stat */
+	static GAMEFEATURESEXTENSION_API void ResetFeatureActivityStats();
+
+	/** Broadcast whenever an action activated, deactivated, was added to a world or finished tearing down */
+	static GAMEFEATURESEXTENSION_API FOnGameFeatureActivityRecorded OnActivityRecorded;
+
+	/** Calls Func for every world action with at least one active context */
+	static GAMEFEATURESEXTENSION_API void ForEachActiveAction(TFunctionRef<void(const UGameFeatureAction_WorldActionBase&)> Func);
+
+	/** Writes every active context of this action, with a summary of its state, to Ar */
+	GAMEFEATURESEXTENSION_API void DumpActiveContexts(FOutputDevice& Ar) const;
+
+	/** Returns the heap memory of the runtime bookkeeping and per-context states of this action */
+	GAMEFEATURESEXTENSION_API SIZE_T GetRuntimeAllocatedSize() const;
+
+	/** Returns FPlatformTime::Seconds() of the most recent activation among the active contexts, or 0 if there is none */
+	GAMEFEATURESEXTENSION_API double GetLastActivationTime() const;
+
 protected:
+	/** Returns true if this action should do anything in the running process, based on its net execution */
+	GAMEFEATURESEXTENSION_API bool IsRelevantForThisProcess() const;
+
+	/** Returns true if this action should be added to the given world, based on its net execution, its conditions and the world */
+	GAMEFEATURESEXTENSION_API bool IsRelevantForWorld(const FWorldContext& WorldContext) const;
+
 	/** Called when the game instance starts */
 	GAMEFEATURESEXTENSION_API void HandleGameInstanceStart(UGameInstance* GameInstance, FGameFeatureStateChangeContext ChangeContext);
 
+	/**
+	 * Subclasses should add every soft reference they resolve once active. These are loaded asynchronously as soon as the feature is loaded
+	 * and kept until it unloads, so activating usually finds them in memory. Activation never waits for them, actions request what is
+	 * still missing themselves.
+	 */
+	GAMEFEATURESEXTENSION_API virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const;
+
 	/** Subclasses should override this to add their world-specific functionality */
 	GAMEFEATURESEXTENSION_API virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
 		PURE_VIRTUAL(UGameFeatureAction_WorldActionBase::OnAddToWorld, );
 
+	/** Brings a single active context in line with the current data. By default the context is reset and added to every relevant world again. */
+	GAMEFEATURESEXTENSION_API virtual void ReconcileContext(const FGameFeatureStateChangeContext& ChangeContext);
+
+	/** Calls Func for every loaded world context the given context applies to and this action is relevant for */
+	GAMEFEATURESEXTENSION_API void ForEachRelevantWorldContext(const FGameFeatureStateChangeContext& ChangeContext, TFunctionRef<void(const FWorldContext&)> Func) const;
+
+	/** Returns a hash of every property of an entry, used to tell which entries changed between two applications of an action */
+	GAMEFEATURESEXTENSION_API static uint32 HashEntry(const UScriptStruct* Struct, const void* Entry);
+
+	template <typename TEntry>
+	static uint32 HashEntry(const TEntry& Entry)
+	{
+		return HashEntry(TEntry::StaticStruct(), &Entry);
+	}
+
+	/**
+	 * Matches the entry hashes of already applied items against the desired ones, every applied item satisfies at most one desired entry.
+	 * Outputs the indices of desired entries that still have to be applied, and the indices of applied items to undo in descending order,
+	 * so they can be removed with RemoveAtSwap while iterating.
+	 */
+	GAMEFEATURESEXTENSION_API static void DiffEntryHashes(TConstArrayView<uint32> AppliedHashes, TConstArrayView<uint32> DesiredHashes, TArray<int32>& OutDesiredToApply, TArray<int32>& OutAppliedToUndo);
+
+	/** Called right before the state of a context is destroyed. Subclasses should undo everything they applied for that context. */
+	GAMEFEATURESEXTENSION_API virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState);
+
+	/**
+	 * Returns true if deactivated contexts of this action can be torn down over several frames with ResetContextStateStep,
+	 * or left in place for a while so activating them again only reconciles what changed.
+	 * The state is no longer registered with its context by then, so actions looking their state up from teardown callbacks should return false.
+	 */
+	GAMEFEATURESEXTENSION_API virtual bool SupportsIncrementalTeardown() const;
+
+	/**
+	 * Undoes one unit of work (e.g. destroying a single actor) of a deactivated context. Only used once GameFeaturesExtension.Teardown.BudgetMs
+	 * is set, it's then called under that budget shared by every world action until it returns true, the feature finishes deactivating once all of its actions are done.
+	 */
+	GAMEFEATURESEXTENSION_API virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState);
+
+	/** Appends a short summary of runtime data this action keeps outside of its contexts (e.g. pools), used by the inspection console commands */
+	GAMEFEATURESEXTENSION_API virtual void DescribeRuntime(FStringBuilderBase& Out) const;
+
+	/** Called for every active context when a world is cleaned up. Subclasses should drop any state referring to that world. */
+	GAMEFEATURESEXTENSION_API virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState);
+
+	/** Returns the state for the given context, creating it if needed. TState must be the same type for every call on this action. */
+	template <typename TState>
+	TState& FindOrAddContextState(const FGameFeatureStateChangeContext& ChangeContext)
+	{
+		static_assert(std::is_base_of_v<FGameFeatureWorldActionContextState, TState>, "TState must derive from FGameFeatureWorldActionContextState");
+
+		TUniquePtr<FGameFeatureWorldActionContextState>& State = FindOrAddContextEntry(ChangeContext).State;
+		if (!State.IsValid())
+		{
+			State = MakeUnique<TState>();
+		}
+		return static_cast<TState&>(*State);
+	}
+
+	/** Returns the state for the given context, or nullptr if the context isn't active. */
+	template <typename TState>
+	TState* FindContextState(const FGameFeatureStateChangeContext& ChangeContext)
+	{
+		const int32 EntryIndex = IndexOfContextEntry(ChangeContext);
+		return EntryIndex != INDEX_NONE ? static_cast<TState*>(Runtime->ContextEntries[EntryIndex].State.Get()) : nullptr;
+	}
+
+	/** Calls Func for the state of every active context. */
+	template <typename TState, typename FuncType>
+	void ForEachContextState(FuncType&& Func)
+	{
+		if (!Runtime.IsValid())
+		{
+			return;
+		}
+
+		for (FContextEntry& Entry : Runtime->ContextEntries)
+		{
+			if (Entry.State.IsValid())
+			{
+				Func(static_cast<TState&>(*Entry.State));
+			}
+		}
+	}
+
+private:
+	struct FContextEntry
+	{
+		FGameFeatureStateChangeContext ChangeContext;
+		FDelegateHandle GameInstanceStartHandle;
+		TUniquePtr<FGameFeatureWorldActionContextState> State;
+
+		/** FPlatformTime::Seconds() of the first activation */
+		double ActivationTime = 0.0;
+	};
+
+	/** Everything an action only needs while it is active. Registers the action as active for as long as it exists. */
+	struct FRuntimeState
+	{
+		explicit FRuntimeState(UGameFeatureAction_WorldActionBase& InOwner);
+		~FRuntimeState();
+
+		UGameFeatureAction_WorldActionBase& Owner;
+
+		/** Active contexts. There are rarely more than a couple at once, so a flat array is both smaller and faster than a map. */
+		TArray<FContextEntry> ContextEntries;
+
+		/** Unbound along with the runtime state */
+		FDelegateHandle WorldCleanupHandle;
+	};
+
+	GAMEFEATURESEXTENSION_API FContextEntry& FindOrAddContextEntry(const FGameFeatureStateChangeContext& ChangeContext);
+	GAMEFEATURESEXTENSION_API int32 IndexOfContextEntry(const FGameFeatureStateChangeContext& ChangeContext) const;
+	void RemoveContextEntry(const FGameFeatureStateChangeContext& ChangeContext);
+
+	/** Removes the entry of a context without resetting it and returns its state */
+	TUniquePtr<FGameFeatureWorldActionContextState> DetachContextEntry(const FGameFeatureStateChangeContext& ChangeContext);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	/** Deactivated contexts being torn down over several frames, shared by every world action */
+	class FTeardownQueue;
+
+	/** Deactivated contexts left in place for GameFeaturesExtension.Teardown.RetainSeconds, shared by every world action */
+	class FRetainedContexts;
+
+	/** Keeps the prewarmed assets loaded from the time the feature is loaded until it unloads */
+	TSharedPtr<FStreamableHandle> PrewarmHandle;
+
+	/** Allocated with the first active context and released with the last one, inactive actions only hold their configuration */
+	TUniquePtr<FRuntimeState> Runtime;
+
+	/** Recompiles CompiledConditionMask from Conditions for the given platform */
+	void CompileConditions(FName PlatformName);
+
+	/** Returns true if the runtime only conditions (game mode, tags) pass for the given world */
+	bool PassesRuntimeConditions(const UWorld& World) const;
+
+protected:
+	/** Restricts the worlds this action applies to */
+	UPROPERTY(EditAnywhere, Category = "Conditions")
+	FGameFeatureActionConditions Conditions;
+
 private:
-	TMap<FGameFeatureStateChangeContext, FDelegateHandle> GameInstanceStartHandles;
+	/** Conditions compiled into allowed net mode, world type and platform bits, tested against a world with a single AND */
+	UPROPERTY()
+	uint32 CompiledConditionMask = 0;
 };
@@ -0,0 +1,120 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+class AActor;
+class FOutputDevice;
+class UObject;
+class UWorld;
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Records the sequence of feature lifecycle transitions and world events the world actions saw into a file,
+ * and replays it while timing every step, turning field reports of activation hitches into repeatable benchmarks.
+ * Replays drive copies of the recorded actions in a transient game instance with synchronous teardown,
+ * the live features and worlds keep their state.
+ *
+ * Driven by the GameFeaturesExtension.Trace.Start/Stop/Replay console commands, e.g. headless with
+ * -nullrhi -ExecCmds="GameFeaturesExtension.Trace.Replay Saved/Traces/Hitch.gftrace 10".
+ */
+class FGameFeatureActivationTrace
+{
+public:
+	enum class EEventType : uint8
+	{
+		Load,
+		Unload,
+		Activate,
+		Deactivate,
+		GameInstanceStart,
+		LocalPlayerAdded,
+		Extension,
+	};
+
+	/** Returns true while a trace is being recorded */
+	static bool IsRecording() { return bRecording; }
+
+	/** Starts recording into Filename, any trace already recording is stopped first */
+	static GAMEFEATURESEXTENSION_API bool StartRecording(const FString& Filename);
+
+	/** Stops recording and writes the trace. Returns false if nothing was recording or the file could not be written. */
+	static GAMEFEATURESEXTENSION_API bool StopRecording();
+
+	/** Replays the trace in Filename NumIterations times, reporting the duration of every step to Ar */
+	static GAMEFEATURESEXTENSION_API bool Replay(const FString& Filename, int32 NumIterations, FOutputDevice& Ar);
+
+	/** Marks the start of a lifecycle callback of an action. Extension events sent from within are caused by the callback and not recorded. */
+	static void EnterAction()
+	{
+		if (bRecording)
+		{
+			++ActionDepth;
+		}
+	}
+
+	/** Marks the end of a lifecycle callback of an action, recording it unless Type is unset */
+	static void LeaveAction(TOptional<EEventType> Type, const UObject& Action, double DurationMs)
+	{
+		if (bRecording)
+		{
+			ActionDepth = FMath::Max(0, ActionDepth - 1);
+			if (Type.IsSet())
+			{
+				RecordActionEvent(Type.GetValue(), Action, DurationMs);
+			}
+		}
+	}
+
+	/** Records an extension event received by a world action. Events sent to the same receiver more than once per frame are only recorded once. */
+	static void RecordExtensionEvent(const AActor* Actor, FName EventName)
+	{
+		if (bRecording && (ActionDepth == 0))
+		{
+			RecordExtensionEventInternal(Actor, EventName);
+		}
+	}
+
+	/** Brackets a lifecycle callback of an action with EnterAction and LeaveAction */
+	class FScopedAction
+	{
+	public:
+		FScopedAction(TOptional<EEventType> InType, const UObject& InAction)
+			: Type(InType)
+			, Action(InAction)
+			, StartTime(FPlatformTime::Seconds())
+		{
+			EnterAction();
+		}
+
+		~FScopedAction()
+		{
+			LeaveAction(Type, Action, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+	private:
+		TOptional<EEventType> Type;
+		const UObject& Action;
+		double StartTime;
+	};
+
+private:
+	static GAMEFEATURESEXTENSION_API void RecordActionEvent(EEventType Type, const UObject& Action, double DurationMs);
+	static GAMEFEATURESEXTENSION_API void RecordExtensionEventInternal(const AActor* Actor, FName EventName);
+
+	static GAMEFEATURESEXTENSION_API bool bRecording;
+	static GAMEFEATURESEXTENSION_API int32 ActionDepth;
+};
+
+#define SCOPED_GAMEFEATURE_ACTIVATION_TRACE(Type, Action) FGameFeatureActivationTrace::FScopedAction PREPROCESSOR_JOIN(ActivationTraceScope, __LINE__)(Type, Action)
+#define RECORD_GAMEFEATURE_EXTENSION_EVENT(Actor, EventName) FGameFeatureActivationTrace::RecordExtensionEvent(Actor, EventName)
+
+#else
+
+#define SCOPED_GAMEFEATURE_ACTIVATION_TRACE(Type, Action)
+#define RECORD_GAMEFEATURE_EXTENSION_EVENT(Actor, EventName)
+
+#endif // !UE_BUILD_SHIPPING
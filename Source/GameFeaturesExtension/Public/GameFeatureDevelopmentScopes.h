@@ -0,0 +1,58 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+
+class IConsoleVariable;
+class UGameInstance;
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * A standalone game instance with its own transient game world, torn down again when this goes out of scope.
+ * Used by development tools to drive world actions without touching the worlds that happen to be loaded.
+ */
+class FGameFeatureTransientGameInstance
+{
+public:
+	GAMEFEATURESEXTENSION_API explicit FGameFeatureTransientGameInstance(const FString& Name);
+	GAMEFEATURESEXTENSION_API ~FGameFeatureTransientGameInstance();
+
+	UGameInstance* Get() const { return GameInstance.Get(); }
+
+	/** Handle of the world context, to restrict feature state changes to this game instance */
+	GAMEFEATURESEXTENSION_API FName GetContextHandle() const;
+
+private:
+	TStrongObjectPtr<UGameInstance> GameInstance;
+};
+
+/**
+ * Tears deactivated contexts down synchronously while in scope, so timings include all of the teardown
+ * and no queued or retained teardown outlives the actions it belongs to.
+ * Variables set with a higher priority than code (e.g. from the console or command line) reject the change, check IsActive.
+ */
+class FScopedSynchronousGameFeatureTeardown
+{
+public:
+	GAMEFEATURESEXTENSION_API FScopedSynchronousGameFeatureTeardown();
+	GAMEFEATURESEXTENSION_API ~FScopedSynchronousGameFeatureTeardown();
+
+	/** Returns false if any of the variables kept a deferred teardown */
+	bool IsActive() const { return bActive; }
+
+private:
+	struct FOverride
+	{
+		IConsoleVariable* Variable = nullptr;
+		FString PriorValue;
+		uint32 PriorSetBy = 0;
+	};
+
+	TArray<FOverride, TInlineAllocator<2>> Overrides;
+	bool bActive = true;
+};
+
+#endif // !UE_BUILD_SHIPPING
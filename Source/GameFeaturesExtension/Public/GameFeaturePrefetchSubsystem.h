@@ -0,0 +1,133 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Ticker.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/SoftObjectPtr.h"
+
+#include "GameFeaturePrefetchSubsystem.generated.h"
+
+class FOutputDevice;
+class UGameFeatureActionSet;
+struct FPrimaryAssetId;
+struct FStreamableHandle;
+
+/** An action set that may be activated next, e.g. the experience of a map the player can travel to */
+USTRUCT(BlueprintType)
+struct FGameFeaturePrefetchCandidate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Prefetch")
+	TSoftObjectPtr<UGameFeatureActionSet> ActionSet;
+
+	/** Relative likelihood of this candidate being next. More likely candidates are warmed first and evicted last. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Prefetch", meta = (ClampMin = "0"))
+	float Likelihood = 1.f;
+};
+
+/**
+ * Warms the features likely to be activated next while the current ones are running, so map-to-map transitions
+ * find most of their feature data resident. Walks the GameFeaturesToEnable and IncludedActionSets of the candidates,
+ * skipping everything the current action set already depends on, mounts the plugins they need and loads the asset
+ * bundles of their game feature data and action sets for the running process.
+ * Only idle plugins are mounted, plugins that are already changing state are left to whoever requested it.
+ *
+ * Only one request is in flight at a time and new ones are only started on frames below GameFeaturesExtension.Prefetch.MaxFrameMs.
+ * While the process uses more than GameFeaturesExtension.Prefetch.MemoryCeilingMB, the least likely features are evicted.
+ * Evicting releases the prefetched assets and returns the plugins the prefetch mounted to Installed.
+ * Nothing ticks once every feature is resident or evicted.
+ */
+UCLASS(MinimalAPI)
+class UGameFeaturePrefetchSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	//~ End USubsystem interface
+
+	/** Replaces the features being prefetched with the dependencies of Candidates that CurrentActionSet doesn't already depend on */
+	UFUNCTION(BlueprintCallable, Category = "Game Features")
+	GAMEFEATURESEXTENSION_API void SetPrefetchTargets(const UGameFeatureActionSet* CurrentActionSet, const TArray<FGameFeaturePrefetchCandidate>& Candidates);
+
+	/** Stops prefetching and releases everything prefetched so far */
+	UFUNCTION(BlueprintCallable, Category = "Game Features")
+	GAMEFEATURESEXTENSION_API void ClearPrefetchTargets();
+
+	/** Returns the number of features whose data is fully prefetched */
+	GAMEFEATURESEXTENSION_API int32 GetNumResidentFeatures() const;
+
+	/** Writes the state of every feature being prefetched to Ar */
+	GAMEFEATURESEXTENSION_API void Dump(FOutputDevice& Ar) const;
+
+private:
+	enum class EFeatureState : uint8
+	{
+		Pending,
+		Mounting,
+		Loading,
+		Resident,
+		Evicted,
+	};
+
+	/** A plugin or action set being prefetched */
+	struct FFeature
+	{
+		/** URL of the plugin, empty for action sets */
+		FString PluginURL;
+
+		/** Path of the action set, null for plugins */
+		FSoftObjectPath ActionSet;
+
+		float Likelihood = 0.f;
+		EFeatureState State = EFeatureState::Pending;
+		TSharedPtr<FStreamableHandle> Handle;
+
+		/** Set when the prefetch registered the plugin, evicting returns it to Installed */
+		bool bMountedByPrefetch = false;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Adds the ticker unless it's running already */
+	void StartTicking();
+
+	/** Returns true while a feature still has to be mounted or loaded */
+	bool HasPendingWork();
+
+	/** Adds the feature with Key unless it's excluded, keeping the highest likelihood it was reached with. Returns true if it was added or raised. */
+	bool AddFeature(const FString& Key, const FString& PluginURL, const FSoftObjectPath& ActionSet, float Likelihood);
+
+	/** Adds the plugins and included action sets of a loaded action set */
+	void AddDependencies(const UGameFeatureActionSet& ActionSet, float Likelihood);
+
+	void StartPrefetch(const FString& Key, FFeature& Feature);
+	void LoadBundles(const FString& Key, const FPrimaryAssetId& AssetId);
+	void HandleLoadComplete(FString Key);
+	void HandlePostGarbageCollect();
+	void Evict(FFeature& Feature);
+
+	/** Returns a plugin the prefetch registered to Installed, unless something else moved it on since */
+	void UnmountPlugin(const FString& PluginURL);
+
+	/** Returns the feature in the given state with the highest (or lowest) likelihood */
+	FFeature* FindFeature(TConstArrayView<EFeatureState> States, bool bMostLikely, FString* OutKey = nullptr);
+
+	TMap<FString, FFeature> Features;
+
+	/** Features of the previous targets while SetPrefetchTargets runs, the ones still wanted keep their progress */
+	TMap<FString, FFeature> PreviousFeatures;
+
+	/** Plugins and action sets the current action set depends on, these are resident anyway */
+	TSet<FString> Excluded;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+
+	/** Evicting only frees memory once garbage is collected, so at most one feature is evicted per collection */
+	bool bCanEvict = true;
+};
@@ -0,0 +1,94 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class FOutputDevice;
+class ULevelStreaming;
+
+/** How urgently an action needs the assets it requests. Requests start in this order. */
+enum class EGameFeatureStreamingPriority : uint8
+{
+	/** Needed to apply gameplay, e.g. input mappings or component classes. Never waits for an in-flight slot. */
+	GameplayCritical,
+
+	/** Needed to show the feature, e.g. widgets, meshes or levels */
+	Visual,
+
+	/** Nice to have early, e.g. prefetching for features that may activate later */
+	Cosmetic,
+};
+
+/**
+ * Coordinates the asset loads of every world action, so heavy feature activation loads in a predictable order
+ * instead of all actions competing for IO at once.
+ *
+ * Requests are handed out as stalled streamable handles and started by priority class, Visual and Cosmetic ones only while
+ * fewer than GameFeaturesExtension.Streaming.MaxInFlight requests are loading (GameFeaturesExtension.Streaming.MaxInFlightCosmetic
+ * for Cosmetic ones). Requests for identical assets from different features share an in-flight slot and start with the most
+ * urgent of them. Level instances are streamed by the world, they are only tracked so they hold back less urgent requests.
+ */
+class FGameFeatureStreamingManager
+{
+public:
+	static GAMEFEATURESEXTENSION_API FGameFeatureStreamingManager& Get();
+
+	/**
+	 * Requests asynchronous loading of Assets. The returned handle may not have started loading yet, it is cancelled
+	 * like any other streamable handle. Returns null if there is nothing to load.
+	 */
+	GAMEFEATURESEXTENSION_API TSharedPtr<FStreamableHandle> RequestAsyncLoad(TArray<FSoftObjectPath> Assets, EGameFeatureStreamingPriority Priority,
+		FStreamableDelegate OnComplete, const FString& DebugName);
+
+	/** Counts a streaming level against the in-flight requests of Priority until it is loaded */
+	GAMEFEATURESEXTENSION_API void TrackLevelStreaming(ULevelStreaming* Level, EGameFeatureStreamingPriority Priority);
+
+	/** Writes the queued and in-flight requests to Ar */
+	GAMEFEATURESEXTENSION_API void Dump(FOutputDevice& Ar) const;
+
+private:
+	struct FRequest
+	{
+		/** Sorted assets of the request, requests for the same assets are merged */
+		TArray<FSoftObjectPath> Assets;
+
+		/** Handles of every caller that requested these assets */
+		TArray<TWeakPtr<FStreamableHandle>> Handles;
+
+		EGameFeatureStreamingPriority Priority = EGameFeatureStreamingPriority::Cosmetic;
+
+		/** Submission order within a priority class */
+		uint64 Serial = 0;
+
+		FString DebugName;
+
+		/** Returns true once every handle completed, was cancelled or was released */
+		bool IsDone() const;
+	};
+
+	struct FTrackedLevel
+	{
+		TWeakObjectPtr<ULevelStreaming> Level;
+		EGameFeatureStreamingPriority Priority = EGameFeatureStreamingPriority::Visual;
+	};
+
+	bool Tick(float DeltaTime);
+
+	/** Drops finished requests and levels, then starts queued requests as far as the in-flight caps allow */
+	void Pump();
+
+	void StartRequest(FRequest& Request);
+	int32 CountInFlight(TOptional<EGameFeatureStreamingPriority> Priority = NullOpt) const;
+
+	TArray<FRequest> Queued;
+	TArray<FRequest> InFlight;
+	TArray<FTrackedLevel> TrackedLevels;
+
+	uint64 NextSerial = 0;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -0,0 +1,34 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+DECLARE_STATS_GROUP(TEXT("GameFeaturesExtension"), STATGROUP_GameFeaturesExtension, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Action Activate"), STAT_GameFeaturesExtension_Activate, STATGROUP_GameFeaturesExtension, GAMEFEATURESEXTENSION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Action Deactivate"), STAT_GameFeaturesExtension_Deactivate, STATGROUP_GameFeaturesExtension, GAMEFEATURESEXTENSION_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("World Action AddToWorld"), STAT_GameFeaturesExtension_AddToWorld, STATGROUP_GameFeaturesExtension, GAMEFEATURESEXTENSION_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Context Entries"), STAT_GameFeaturesExtension_LiveContextEntries, STATGROUP_GameFeaturesExtension, GAMEFEATURESEXTENSION_API);
+
+LLM_DECLARE_TAG_API(GameFeaturesExtension, GAMEFEATURESEXTENSION_API);
+
+UE_TRACE_CHANNEL_EXTERN(GameFeaturesExtensionChannel, GAMEFEATURESEXTENSION_API);
+
+/** Timing event on the GameFeaturesExtension trace channel. Name is a literal, so there is one event per call site however many actors and packages pass through. */
+#define TRACE_GAMEFEATURESEXTENSION_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, GameFeaturesExtensionChannel)
+
+/** Timing event as above, preceded by a bookmark with the details formatted from Format (e.g. the action's package or the actor) while the channel is enabled */
+#define TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(Name, Format, ...) \
+	if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GameFeaturesExtensionChannel)) { TRACE_BOOKMARK(Name TEXT(" ") Format, ##__VA_ARGS__); } \
+	TRACE_GAMEFEATURESEXTENSION_SCOPE(Name)
+
+/** Attributes allocations in the current scope to the GameFeaturesExtension tag and, with asset tags enabled, to the package owning Object */
+#define LLM_SCOPE_GAMEFEATURESEXTENSION(Object) \
+	LLM_SCOPE_BYTAG(GameFeaturesExtension); \
+	LLM_SCOPE_DYNAMIC_STAT_OBJECTPATH((Object)->GetPackage(), ELLMTagSet::Assets)
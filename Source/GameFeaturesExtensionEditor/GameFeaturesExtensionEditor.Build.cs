@@ -17,7 +17,9 @@ public class GameFeaturesExtensionEditor : ModuleRules
         PrivateDependencyModuleNames.AddRange(
             new string[]
             {
+                "AssetRegistry",
                 "CoreUObject",
+                "DataValidation",
                 "Slate",
                 "SlateCore",
                 "InputCore",
@@ -26,7 +28,8 @@ public class GameFeaturesExtensionEditor : ModuleRules
                 "Projects",
                 "GameFeatures",
                 "GameFeaturesExtension",
-                "SharedSettingsWidgets"
+                "SharedSettingsWidgets",
+                "WorkspaceMenuStructure"
             }
         );
     }
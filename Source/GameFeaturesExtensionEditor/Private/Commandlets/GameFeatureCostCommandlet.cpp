@@ -0,0 +1,109 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureCostCommandlet.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "GameFeatureActionCostEstimator.h"
+#include "GameFeatureActionSet.h"
+#include "GameFeatureData.h"
+#include "GameFeaturesSubsystem.h"
+#include "Misc/DataValidation.h"
+
+UGameFeatureCostCommandlet::UGameFeatureCostCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UGameFeatureCostCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const bool bVerbose = Switches.Contains(TEXT("Verbose"));
+
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> FeatureAssets;
+	if (const FString* AssetsParam = ParamsMap.Find(TEXT("Assets")))
+	{
+		TArray<FString> AssetPaths;
+		AssetsParam->ParseIntoArray(AssetPaths, TEXT("+"));
+		for (const FString& AssetPath : AssetPaths)
+		{
+			const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(FSoftObjectPath(AssetPath));
+			if (AssetData.IsValid())
+			{
+				FeatureAssets.Add(AssetData);
+			}
+			else
+			{
+				UE_LOG(LogGameFeatures, Error, TEXT("GameFeatureCost: %s was not found in the asset registry"), *AssetPath);
+				return 1;
+			}
+		}
+	}
+	else
+	{
+		AssetRegistry.GetAssetsByClass(UGameFeatureData::StaticClass()->GetClassPathName(), FeatureAssets, true);
+		AssetRegistry.GetAssetsByClass(UGameFeatureActionSet::StaticClass()->GetClassPathName(), FeatureAssets, true);
+	}
+
+	int32 NumOverBudget = 0;
+	for (const FAssetData& AssetData : FeatureAssets)
+	{
+		const UObject* FeatureAsset = AssetData.GetAsset();
+		if (FeatureAsset == nullptr)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("GameFeatureCost: failed to load %s"), *AssetData.GetObjectPathString());
+			++NumOverBudget;
+			continue;
+		}
+
+		const FGameFeatureCostReport Report = FGameFeatureActionCostEstimator::EstimateActions(FGameFeatureActionCostEstimator::GetFeatureActions(*FeatureAsset));
+
+		UE_LOG(LogGameFeatures, Display, TEXT("%-64s Actions: %3d  Packages: %6d  Disk: %10.2f MB  EstimatedMemory: %10.2f MB"),
+			*AssetData.GetObjectPathString(), Report.Actions.Num(), Report.NumPackages, Report.DiskBytes / (1024.0 * 1024.0), Report.EstimatedMemoryBytes / (1024.0 * 1024.0));
+
+		FDataValidationContext Context;
+		bool bWithinBudget = FGameFeatureActionCostEstimator::CheckFeatureBudgets(Report, Context);
+
+		for (const FGameFeatureActionCost& Cost : Report.Actions)
+		{
+			bWithinBudget &= FGameFeatureActionCostEstimator::CheckActionBudgets(Cost, Context);
+
+			if (bVerbose)
+			{
+				TStringBuilder<256> AssetCounts;
+				for (const TPair<FName, int32>& Pair : Cost.AssetCountsByClass)
+				{
+					AssetCounts.Appendf(TEXT("%s=%d "), *Pair.Key.ToString(), Pair.Value);
+				}
+
+				UE_LOG(LogGameFeatures, Display, TEXT("    %-60s Packages: %6d  Disk: %10.2f MB  Assets: %s"),
+					*Cost.ActionName, Cost.Packages.Num(), Cost.DiskBytes / (1024.0 * 1024.0), *AssetCounts);
+			}
+		}
+
+		for (const FDataValidationContext::FIssue& Issue : Context.GetIssues())
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("GameFeatureCost: %s: %s"), *AssetData.GetObjectPathString(), *Issue.Message.ToString());
+		}
+
+		if (!bWithinBudget)
+		{
+			++NumOverBudget;
+		}
+	}
+
+	UE_LOG(LogGameFeatures, Display, TEXT("GameFeatureCost: %d of %d features over budget"), NumOverBudget, FeatureAssets.Num());
+
+	return (NumOverBudget > 0) ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GameFeatureCostCommandlet.generated.h"
+
+/**
+ * Reports the static activation cost of game feature data and action sets and fails when a budget is exceeded,
+ * so build pipelines catch heavy features before they ship.
+ *
+ * Usage: -run=GameFeatureCost [-Assets=/Game/Path/Asset+/Other/Asset] [-Verbose]
+ * Without -Assets every game feature data and action set known to the asset registry is checked.
+ * Budgets are the GameFeaturesExtension.Cost.* console variables, e.g. -ini:Engine:[ConsoleVariables]:GameFeaturesExtension.Cost.MaxFeatureDiskSizeMB=64
+ */
+UCLASS()
+class UGameFeatureCostCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UGameFeatureCostCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -8,10 +8,15 @@
 #include "GameFeatureData.h"
 #include "GameFeaturesSubsystem.h"
 #include "Engine/AssetManagerSettings.h"
+#include "Framework/Docking/TabManager.h"
 #include "Framework/Notifications/NotificationManager.h"
+#include "WorkspaceMenuStructure.h"
+#include "WorkspaceMenuStructureModule.h"
 
 #include "Styles/GameFeaturesExtensionEditorStyle.h"
 #include "Widgets/SGameFeaturePluginURLPicker.h"
+#include "Widgets/SGameFeaturesDashboard.h"
+#include "Widgets/Docking/SDockTab.h"
 #include "Widgets/Notifications/SNotificationList.h"
 
 #define LOCTEXT_NAMESPACE "FGameFeaturesExtensionEditorModule"
@@ -26,6 +31,12 @@ void FGameFeaturesExtensionEditorModule::StartupModule()
 
 	FGameFeaturesExtensionEditorStyle::Get();
 
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(SGameFeaturesDashboard::TabName, FOnSpawnTab::CreateRaw(this, &FGameFeaturesExtensionEditorModule::SpawnDashboardTab))
+		.SetDisplayName(LOCTEXT("DashboardTabTitle", "Game Features Dashboard"))
+		.SetTooltipText(LOCTEXT("DashboardTabToolTip", "Shows the game features with active world actions and what activating them cost"))
+		.SetGroup(WorkspaceMenu::GetMenuStructure().GetDeveloperToolsDebugCategory())
+		.SetIcon(FSlateIcon(FGameFeaturesExtensionEditorStyle::Get().GetStyleSetName(), "Icon.GameFeaturePlugin"));
+
 	UAssetManager::CallOrRegister_OnAssetManagerCreated(
 			FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FGameFeaturesExtensionEditorModule::OnAssetManagerCreated));
 }
@@ -39,6 +50,11 @@ void FGameFeaturesExtensionEditorModule::OnAssetManagerCreated()
 
 void FGameFeaturesExtensionEditorModule::ShutdownModule()
 {
+	if (FSlateApplication::IsInitialized())
+	{
+		FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(SGameFeaturesDashboard::TabName);
+	}
+
     FGameFeaturesExtensionEditorStyle::Shutdown();
 }
 
@@ -48,6 +64,15 @@ TSharedRef<SWidget> FGameFeaturesExtensionEditorModule::CreateGameFeaturePluginP
 		.OnPicked(OnPicked);
 }
 
+TSharedRef<SDockTab> FGameFeaturesExtensionEditorModule::SpawnDashboardTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		[
+			SNew(SGameFeaturesDashboard)
+		];
+}
+
 void FGameFeaturesExtensionEditorModule::CheckPrimaryAssetDataRule(UClass* AssetClass, FPrimaryAssetTypeInfo TypeInfo)
 {
 	const FPrimaryAssetId TestAssetId(AssetClass->GetFName(), NAME_None);
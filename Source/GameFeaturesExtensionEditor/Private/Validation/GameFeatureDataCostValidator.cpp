@@ -0,0 +1,35 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureDataCostValidator.h"
+
+#include "GameFeatureActionCostEstimator.h"
+#include "GameFeatureData.h"
+#include "Misc/DataValidation.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureDataCostValidator)
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+bool UGameFeatureDataCostValidator::CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const
+{
+	return Cast<UGameFeatureData>(InObject) != nullptr;
+}
+
+EDataValidationResult UGameFeatureDataCostValidator::ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context)
+{
+	const FGameFeatureCostReport Report = FGameFeatureActionCostEstimator::EstimateActions(FGameFeatureActionCostEstimator::GetFeatureActions(*InAsset));
+
+	// Overruns are added to the context as warnings, only fail the asset if they are configured to be errors
+	if (!FGameFeatureActionCostEstimator::CheckFeatureBudgets(Report, Context) &&
+		(FGameFeatureActionCostEstimator::GetOverBudgetResult() == EDataValidationResult::Invalid))
+	{
+		AssetFails(InAsset, LOCTEXT("GameFeatureDataOverBudget", "Game feature exceeds its activation cost budget."));
+		return EDataValidationResult::Invalid;
+	}
+
+	AssetPasses(InAsset);
+	return EDataValidationResult::Valid;
+}
+
+#undef LOCTEXT_NAMESPACE
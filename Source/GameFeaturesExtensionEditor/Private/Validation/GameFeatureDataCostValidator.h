@@ -0,0 +1,24 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorValidatorBase.h"
+
+#include "GameFeatureDataCostValidator.generated.h"
+
+/**
+ * Checks the static activation cost of game feature data against the GameFeaturesExtension.Cost.* feature budgets.
+ * Action sets check their own budgets in IsDataValid, game feature data lives in the GameFeatures plugin and is covered here instead.
+ */
+UCLASS()
+class UGameFeatureDataCostValidator : public UEditorValidatorBase
+{
+	GENERATED_BODY()
+
+protected:
+	//~ Begin UEditorValidatorBase Interface
+	virtual bool CanValidateAsset_Implementation(const FAssetData& InAssetData, UObject* InObject, FDataValidationContext& InContext) const override;
+	virtual EDataValidationResult ValidateLoadedAsset_Implementation(const FAssetData& InAssetData, UObject* InAsset, FDataValidationContext& Context) override;
+	//~ End UEditorValidatorBase Interface
+};
@@ -0,0 +1,396 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "SGameFeaturesDashboard.h"
+
+#include "Editor.h"
+#include "GameFeatureAction_WorldActionBase.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/OutputDevice.h"
+#include "SlateOptMacros.h"
+#include "Styling/AppStyle.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+#include "Widgets/Images/SImage.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Layout/SScrollBorder.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+#define LOCTEXT_NAMESPACE "GameFeaturesDashboard"
+
+const FName SGameFeaturesDashboard::TabName(TEXT("GameFeaturesDashboard"));
+
+namespace UE::GameFeaturesExtension::Dashboard
+{
+	static const FName Column_Name(TEXT("Name"));
+	static const FName Column_Contexts(TEXT("Contexts"));
+	static const FName Column_Activations(TEXT("Activations"));
+	static const FName Column_ActivationMs(TEXT("ActivationMs"));
+	static const FName Column_DeactivationMs(TEXT("DeactivationMs"));
+	static const FName Column_MemoryDelta(TEXT("MemoryDelta"));
+	static const FName Column_Bookkeeping(TEXT("Bookkeeping"));
+	static const FName Column_LastActivation(TEXT("LastActivation"));
+	static const FName Column_Open(TEXT("Open"));
+
+	/** Collects the lines written to an output device, used to show the context summaries as a tooltip */
+	class FToolTipOutputDevice final : public FOutputDevice
+	{
+	public:
+		virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override
+		{
+			if (!Text.IsEmpty())
+			{
+				Text += LINE_TERMINATOR;
+			}
+			Text += V;
+		}
+
+		FString Text;
+	};
+}
+
+class SGameFeaturesDashboardRow : public SMultiColumnTableRow<TSharedPtr<FGameFeaturesDashboardItem>>
+{
+public:
+	SLATE_BEGIN_ARGS(SGameFeaturesDashboardRow)
+	{
+	}
+		SLATE_ARGUMENT(TSharedPtr<FGameFeaturesDashboardItem>, Item)
+	SLATE_END_ARGS()
+
+public:
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView)
+	{
+		Item = InArgs._Item;
+
+		SMultiColumnTableRow::Construct(FSuperRowType::FArguments(), InOwnerTableView);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		using namespace UE::GameFeaturesExtension::Dashboard;
+
+		if (ColumnName == Column_Name)
+		{
+			return SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				[
+					SNew(SExpanderArrow, SharedThis(this))
+				]
+
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.f)
+				.Padding(0.f, 3.f, 6.f, 3.f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &SGameFeaturesDashboardRow::GetNameText)
+					.ToolTipText(this, &SGameFeaturesDashboardRow::GetContextsToolTipText)
+				];
+		}
+
+		if (ColumnName == Column_Open)
+		{
+			return SNew(SButton)
+				.ButtonStyle(FAppStyle::Get(), "SimpleButton")
+				.ToolTipText(LOCTEXT("OpenAssetToolTip", "Open the asset owning this action"))
+				.Visibility(this, &SGameFeaturesDashboardRow::GetOpenVisibility)
+				.OnClicked(this, &SGameFeaturesDashboardRow::OnOpenClicked)
+				[
+					SNew(SImage)
+					.Image(FAppStyle::GetBrush("Icons.OpenInExternalEditor"))
+					.ColorAndOpacity(FSlateColor::UseForeground())
+				];
+		}
+
+		return SNew(STextBlock)
+			.Text(this, &SGameFeaturesDashboardRow::GetColumnText, ColumnName);
+	}
+
+private:
+	const FGameFeatureActivityStats* FindStats() const
+	{
+		return UGameFeatureAction_WorldActionBase::GetFeatureActivityStats().Find(Item->FeatureName);
+	}
+
+	FText GetNameText() const
+	{
+		if (Item->IsFeature())
+		{
+			return FText::FromName(Item->FeatureName);
+		}
+
+		const UGameFeatureAction_WorldActionBase* Action = Item->Action.Get();
+		return Action ? Action->GetClass()->GetDisplayNameText() : LOCTEXT("StaleAction", "(Destroyed)");
+	}
+
+	FText GetContextsToolTipText() const
+	{
+		const UGameFeatureAction_WorldActionBase* Action = Item->Action.Get();
+		if (Action == nullptr)
+		{
+			return FText::GetEmpty();
+		}
+
+		UE::GameFeaturesExtension::Dashboard::FToolTipOutputDevice Output;
+		Action->DumpActiveContexts(Output);
+		return FText::FromString(Output.Text);
+	}
+
+	FText GetColumnText(FName ColumnName) const
+	{
+		using namespace UE::GameFeaturesExtension::Dashboard;
+
+		const UGameFeatureAction_WorldActionBase* Action = Item->Action.Get();
+
+		if (ColumnName == Column_Contexts)
+		{
+			return Action ? FText::AsNumber(Action->GetNumContextEntries()) : FText::GetEmpty();
+		}
+
+		if (ColumnName == Column_Bookkeeping)
+		{
+			return Action ? FText::AsMemory(Action->GetRuntimeAllocatedSize()) : FText::GetEmpty();
+		}
+
+		if (ColumnName == Column_LastActivation)
+		{
+			const double LastActivationTime = Action ? Action->GetLastActivationTime() : (FindStats() ? FindStats()->LastActivationTime : 0.0);
+			if (LastActivationTime <= 0.0)
+			{
+				return FText::GetEmpty();
+			}
+
+			return FText::Format(LOCTEXT("SecondsAgo", "{0}s ago"), FText::AsNumber(FMath::FloorToInt(FPlatformTime::Seconds() - LastActivationTime)));
+		}
+
+		// Activity is recorded per feature
+		const FGameFeatureActivityStats* Stats = Item->IsFeature() ? FindStats() : nullptr;
+		if (Stats == nullptr)
+		{
+			return FText::GetEmpty();
+		}
+
+		FNumberFormattingOptions MsFormat;
+		MsFormat.MinimumFractionalDigits = 2;
+		MsFormat.MaximumFractionalDigits = 2;
+
+		if (ColumnName == Column_Activations)
+		{
+			return FText::Format(LOCTEXT("ActivationCounts", "{0} / {1}"), FText::AsNumber(Stats->NumActivations), FText::AsNumber(Stats->NumDeactivations));
+		}
+
+		if (ColumnName == Column_ActivationMs)
+		{
+			return FText::AsNumber(Stats->ActivationSeconds * 1000.0, &MsFormat);
+		}
+
+		if (ColumnName == Column_DeactivationMs)
+		{
+			return FText::AsNumber(Stats->DeactivationSeconds * 1000.0, &MsFormat);
+		}
+
+		if (ColumnName == Column_MemoryDelta)
+		{
+			const int64 DeltaBytes = Stats->ActivationBytes + Stats->DeactivationBytes;
+			return (DeltaBytes < 0)
+				? FText::Format(LOCTEXT("NegativeMemory", "-{0}"), FText::AsMemory(static_cast<uint64>(-DeltaBytes)))
+				: FText::AsMemory(static_cast<uint64>(DeltaBytes));
+		}
+
+		return FText::GetEmpty();
+	}
+
+	EVisibility GetOpenVisibility() const
+	{
+		return Item->Action.IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+	}
+
+	FReply OnOpenClicked()
+	{
+		const UGameFeatureAction_WorldActionBase* Action = Item->Action.Get();
+		UObject* Asset = Action ? Action->GetOutermostObject() : nullptr;
+		if (Asset && GEditor)
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Asset);
+		}
+
+		return FReply::Handled();
+	}
+
+	TSharedPtr<FGameFeaturesDashboardItem> Item;
+};
+
+SGameFeaturesDashboard::~SGameFeaturesDashboard()
+{
+	UGameFeatureAction_WorldActionBase::OnActivityRecorded.Remove(ActivityRecordedHandle);
+}
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+void SGameFeaturesDashboard::Construct(const FArguments& InArgs)
+{
+	using namespace UE::GameFeaturesExtension::Dashboard;
+
+	SAssignNew(FeaturesTree, STreeView<TSharedPtr<FGameFeaturesDashboardItem>>)
+	.SelectionMode(ESelectionMode::Single)
+	.TreeItemsSource(&Features)
+	.OnGenerateRow(this, &SGameFeaturesDashboard::OnGenerateRow)
+	.OnGetChildren(this, &SGameFeaturesDashboard::OnGetChildren)
+	.HeaderRow
+	(
+		SNew(SHeaderRow)
+		+ SHeaderRow::Column(Column_Name)
+		.FillWidth(0.34f)
+		.DefaultLabel(LOCTEXT("NameColumn", "Feature / Action"))
+		+ SHeaderRow::Column(Column_Contexts)
+		.FillWidth(0.06f)
+		.DefaultLabel(LOCTEXT("ContextsColumn", "Contexts"))
+		+ SHeaderRow::Column(Column_Activations)
+		.FillWidth(0.08f)
+		.DefaultLabel(LOCTEXT("ActivationsColumn", "Activations"))
+		.DefaultTooltip(LOCTEXT("ActivationsColumnToolTip", "Activations / deactivations since the counters were last reset"))
+		+ SHeaderRow::Column(Column_ActivationMs)
+		.FillWidth(0.09f)
+		.DefaultLabel(LOCTEXT("ActivationMsColumn", "Activate (ms)"))
+		+ SHeaderRow::Column(Column_DeactivationMs)
+		.FillWidth(0.09f)
+		.DefaultLabel(LOCTEXT("DeactivationMsColumn", "Deactivate (ms)"))
+		+ SHeaderRow::Column(Column_MemoryDelta)
+		.FillWidth(0.1f)
+		.DefaultLabel(LOCTEXT("MemoryDeltaColumn", "Memory Delta"))
+		.DefaultTooltip(LOCTEXT("MemoryDeltaColumnToolTip", "Memory kept by activating and deactivating the feature. Only sampled while GameFeaturesExtension.TrackMemoryDeltas is enabled."))
+		+ SHeaderRow::Column(Column_Bookkeeping)
+		.FillWidth(0.1f)
+		.DefaultLabel(LOCTEXT("BookkeepingColumn", "Bookkeeping"))
+		.DefaultTooltip(LOCTEXT("BookkeepingColumnToolTip", "Memory of the per-context state, hover the action name for what it holds"))
+		+ SHeaderRow::Column(Column_LastActivation)
+		.FillWidth(0.1f)
+		.DefaultLabel(LOCTEXT("LastActivationColumn", "Last Activation"))
+		+ SHeaderRow::Column(Column_Open)
+		.FixedWidth(28.f)
+		.DefaultLabel(FText::GetEmpty())
+	);
+
+	this->ChildSlot
+	[
+		SNew(SVerticalBox)
+
+		// Toolbar
+		+ SVerticalBox::Slot()
+		.AutoHeight()
+		.Padding(8.f, 4.f)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(STextBlock)
+				.Text(this, &SGameFeaturesDashboard::GetSummaryText)
+			]
+
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			[
+				SNew(SButton)
+				.Text(LOCTEXT("ResetCounters", "Reset Counters"))
+				.ToolTipText(LOCTEXT("ResetCountersToolTip", "Clears the activation counters, timings and memory deltas recorded per feature"))
+				.OnClicked(this, &SGameFeaturesDashboard::OnResetCountersClicked)
+			]
+		]
+
+		// Features and their actions
+		+ SVerticalBox::Slot()
+		.FillHeight(1.f)
+		[
+			SNew(SScrollBorder, FeaturesTree.ToSharedRef())
+			[
+				FeaturesTree.ToSharedRef()
+			]
+		]
+	];
+
+	ActivityRecordedHandle = UGameFeatureAction_WorldActionBase::OnActivityRecorded.AddSP(this, &SGameFeaturesDashboard::HandleActivityRecorded);
+	bNeedsRefresh = true;
+}
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+void SGameFeaturesDashboard::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	// Activity usually comes in bursts, rebuild once per frame at most
+	if (bNeedsRefresh)
+	{
+		bNeedsRefresh = false;
+		PopulateFeatureList();
+	}
+}
+
+TSharedRef<ITableRow> SGameFeaturesDashboard::OnGenerateRow(TSharedPtr<FGameFeaturesDashboardItem> InItem, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SGameFeaturesDashboardRow, OwnerTable)
+		.Item(InItem);
+}
+
+void SGameFeaturesDashboard::OnGetChildren(TSharedPtr<FGameFeaturesDashboardItem> InItem, TArray<TSharedPtr<FGameFeaturesDashboardItem>>& OutChildren)
+{
+	OutChildren = InItem->Children;
+}
+
+FText SGameFeaturesDashboard::GetSummaryText() const
+{
+	return FText::Format(LOCTEXT("SummaryLabel", "{0} {0}|plural(one=feature,other=features) with {1} active {1}|plural(one=action,other=actions)"),
+		Features.Num(), NumActions);
+}
+
+FReply SGameFeaturesDashboard::OnResetCountersClicked()
+{
+	UGameFeatureAction_WorldActionBase::ResetFeatureActivityStats();
+	FeaturesTree->RebuildList();
+	return FReply::Handled();
+}
+
+void SGameFeaturesDashboard::HandleActivityRecorded(const UGameFeatureAction_WorldActionBase& Action)
+{
+	bNeedsRefresh = true;
+}
+
+void SGameFeaturesDashboard::PopulateFeatureList()
+{
+	TMap<FName, TSharedPtr<FGameFeaturesDashboardItem>> FeaturesByName;
+	NumActions = 0;
+
+	UGameFeatureAction_WorldActionBase::ForEachActiveAction([this, &FeaturesByName](const UGameFeatureAction_WorldActionBase& Action)
+		{
+			const FName FeatureName = Action.GetPackage()->GetFName();
+
+			TSharedPtr<FGameFeaturesDashboardItem>& Feature = FeaturesByName.FindOrAdd(FeatureName);
+			if (!Feature.IsValid())
+			{
+				Feature = MakeShared<FGameFeaturesDashboardItem>();
+				Feature->FeatureName = FeatureName;
+			}
+
+			TSharedPtr<FGameFeaturesDashboardItem> ActionItem = MakeShared<FGameFeaturesDashboardItem>();
+			ActionItem->FeatureName = FeatureName;
+			ActionItem->Action = &Action;
+			Feature->Children.Add(ActionItem);
+
+			++NumActions;
+		});
+
+	FeaturesByName.KeySort(FNameLexicalLess());
+
+	Features.Reset();
+	FeaturesByName.GenerateValueArray(Features);
+
+	for (const TSharedPtr<FGameFeaturesDashboardItem>& Feature : Features)
+	{
+		FeaturesTree->SetItemExpansion(Feature, true);
+	}
+
+	FeaturesTree->RequestTreeRefresh();
+}
+
+#undef LOCTEXT_NAMESPACE
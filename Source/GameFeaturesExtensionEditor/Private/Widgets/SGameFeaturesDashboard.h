@@ -0,0 +1,63 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/STreeView.h"
+
+class UGameFeatureAction_WorldActionBase;
+
+/** A feature (the package owning the actions) or one of its active world actions */
+class FGameFeaturesDashboardItem : public TSharedFromThis<FGameFeaturesDashboardItem>
+{
+public:
+	/** Package of the game feature data or action set owning the actions */
+	FName FeatureName;
+
+	/** Unset for feature rows */
+	TWeakObjectPtr<const UGameFeatureAction_WorldActionBase> Action;
+
+	TArray<TSharedPtr<FGameFeaturesDashboardItem>> Children;
+
+	bool IsFeature() const { return Action.IsExplicitlyNull(); }
+};
+
+/**
+ * Lists the game features with active world actions, e.g. while playing in editor, along with what their actions cost.
+ * Refreshed when the actions record activity rather than by polling, so an idle session costs nothing.
+ */
+class SGameFeaturesDashboard : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SGameFeaturesDashboard)
+		{
+		}
+	SLATE_END_ARGS()
+
+public:
+	virtual ~SGameFeaturesDashboard() override;
+
+	void Construct(const FArguments& InArgs);
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
+	/** Name of the nomad tab hosting the dashboard */
+	static const FName TabName;
+
+private:
+	TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FGameFeaturesDashboardItem> InItem, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetChildren(TSharedPtr<FGameFeaturesDashboardItem> InItem, TArray<TSharedPtr<FGameFeaturesDashboardItem>>& OutChildren);
+	FText GetSummaryText() const;
+	FReply OnResetCountersClicked();
+
+	void HandleActivityRecorded(const UGameFeatureAction_WorldActionBase& Action);
+	void PopulateFeatureList();
+
+private:
+	TSharedPtr<STreeView<TSharedPtr<FGameFeaturesDashboardItem>>> FeaturesTree;
+	TArray<TSharedPtr<FGameFeaturesDashboardItem>> Features;
+
+	FDelegateHandle ActivityRecordedHandle;
+	int32 NumActions = 0;
+	bool bNeedsRefresh = false;
+};
@@ -4,6 +4,9 @@
 #include "Engine/AssetManagerTypes.h"
 #include "Modules/ModuleManager.h"
 
+class FSpawnTabArgs;
+class SDockTab;
+
 /** Delegate used to notify when a game feature plugin has been picked */
 DECLARE_DELEGATE_OneParam(FOnGameFeaturePluginPicked, const FString&);
 
@@ -20,5 +23,6 @@ public:
 
 private:
     void OnAssetManagerCreated();
+    TSharedRef<SDockTab> SpawnDashboardTab(const FSpawnTabArgs& SpawnTabArgs);
     void AddPrimaryAssetDataRule(UClass* AssetClass, FPrimaryAssetTypeInfo TypeInfo);
 };
@@ -0,0 +1,24 @@
+﻿// Copyright © 2025 MajorT. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class GameFeaturesExtensionMass : ModuleRules
+{
+	public GameFeaturesExtensionMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicDependencyModuleNames.AddRange(new[]
+		{
+			"Core",
+			"GameFeatures",
+			"GameFeaturesExtension",
+			"MassEntity",
+			"MassSpawner",
+		});
+
+		PrivateDependencyModuleNames.AddRange(new[]
+		{
+			"CoreUObject",
+			"Engine",
+		});
+	}
+}
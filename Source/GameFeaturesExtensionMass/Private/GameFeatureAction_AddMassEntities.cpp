@@ -0,0 +1,395 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "GameFeatureAction_AddMassEntities.h"
+
+#include "AssetRegistry/AssetBundleData.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "GameFeaturesExtensionStats.h"
+#include "GameFeatureStreamingManager.h"
+#include "GameFeaturesSubsystemSettings.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Text.h"
+#include "MassEntityConfigAsset.h"
+#include "MassEntitySpawnDataGeneratorBase.h"
+#include "MassEntityTemplate.h"
+#include "MassSpawnerSubsystem.h"
+
+#if WITH_EDITOR
+#include "Misc/DataValidation.h"
+#include "UObject/Package.h"
+#include "UnrealEngine.h"
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(GameFeatureAction_AddMassEntities)
+
+#define LOCTEXT_NAMESPACE "GameFeatures"
+
+//////////////////////////////////////////////////////////////////////
+// UGameFeatureAction_AddMassEntities
+
+#if WITH_EDITORONLY_DATA
+void UGameFeatureAction_AddMassEntities::AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData)
+{
+	if (UAssetManager::IsInitialized())
+	{
+		for (const FGameFeatureMassSpawnEntry& Entry : SpawnList)
+		{
+			for (const FMassSpawnedEntityType& EntityType : Entry.EntityTypes)
+			{
+				if (EntityType.EntityConfig.IsNull())
+				{
+					continue;
+				}
+
+				AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateClient, EntityType.EntityConfig.ToSoftObjectPath().GetAssetPath());
+				AssetBundleData.AddBundleAsset(UGameFeaturesSubsystemSettings::LoadStateServer, EntityType.EntityConfig.ToSoftObjectPath().GetAssetPath());
+			}
+		}
+	}
+}
+#endif
+
+#if WITH_EDITOR
+EDataValidationResult UGameFeatureAction_AddMassEntities::IsDataValid(FDataValidationContext& Context) const
+{
+	EDataValidationResult Result = CombineDataValidationResults(Super::IsDataValid(Context), EDataValidationResult::Valid);
+
+	int32 EntryIndex = 0;
+	for (const FGameFeatureMassSpawnEntry& Entry : SpawnList)
+	{
+		int32 TypeIndex = 0;
+		for (const FMassSpawnedEntityType& EntityType : Entry.EntityTypes)
+		{
+			if (EntityType.EntityConfig.IsNull())
+			{
+				Result = EDataValidationResult::Invalid;
+				Context.AddError(FText::Format(LOCTEXT("NullMassEntityConfig", "Null EntityConfig for entity type #{0} at index {1} in SpawnList."), FText::AsNumber(TypeIndex), FText::AsNumber(EntryIndex)));
+			}
+			++TypeIndex;
+		}
+
+		int32 GeneratorIndex = 0;
+		for (const FMassSpawnDataGenerator& Generator : Entry.SpawnDataGenerators)
+		{
+			if (Generator.GeneratorInstance == nullptr)
+			{
+				Result = EDataValidationResult::Invalid;
+				Context.AddError(FText::Format(LOCTEXT("NullMassSpawnGenerator", "Null GeneratorInstance for generator #{0} at index {1} in SpawnList."), FText::AsNumber(GeneratorIndex), FText::AsNumber(EntryIndex)));
+			}
+			++GeneratorIndex;
+		}
+
+		if ((Entry.Count > 0) && (Entry.EntityTypes.IsEmpty() || Entry.SpawnDataGenerators.IsEmpty()))
+		{
+			Result = EDataValidationResult::Invalid;
+			Context.AddError(FText::Format(LOCTEXT("IncompleteMassSpawnEntry", "Entry at index {0} in SpawnList needs at least one entity type and one spawn data generator."), FText::AsNumber(EntryIndex)));
+		}
+
+		++EntryIndex;
+	}
+
+	return Result;
+}
+#endif
+
+void UGameFeatureAction_AddMassEntities::GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for (const FGameFeatureMassSpawnEntry& Entry : SpawnList)
+	{
+		for (const FMassSpawnedEntityType& EntityType : Entry.EntityTypes)
+		{
+			OutAssets.Add(EntityType.EntityConfig.ToSoftObjectPath());
+		}
+	}
+}
+
+void UGameFeatureAction_AddMassEntities::OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	UWorld* World = WorldContext.World();
+
+	if ((World == nullptr) || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	if (UWorld::GetSubsystem<UMassSpawnerSubsystem>(World) == nullptr)
+	{
+		return;
+	}
+
+	// Created up front, generators are allowed to finish synchronously
+	FPerContextData& ActiveData = FindOrAddContextState<FPerContextData>(ChangeContext);
+
+	TArray<FSoftObjectPath> ConfigsToLoad;
+	{
+#if WITH_EDITOR
+		// Allow resolving of TargetWorld in proper context
+		FTemporaryPlayInEditorIDOverride IDHelper(World->GetPackage()->GetPIEInstanceID());
+#endif
+
+		for (const FGameFeatureMassSpawnEntry& Entry : SpawnList)
+		{
+			if (!IsEntryForWorld(Entry, *World))
+			{
+				continue;
+			}
+
+			for (const FMassSpawnedEntityType& EntityType : Entry.EntityTypes)
+			{
+				if (EntityType.EntityConfig.IsPending())
+				{
+					ConfigsToLoad.AddUnique(EntityType.EntityConfig.ToSoftObjectPath());
+				}
+			}
+		}
+	}
+
+	if (ConfigsToLoad.IsEmpty())
+	{
+		GenerateSpawnData(*World, ChangeContext);
+		return;
+	}
+
+	// Generators need the entity configs, they run from the load callback
+	TSharedPtr<FStreamableHandle> LoadHandle = FGameFeatureStreamingManager::Get().RequestAsyncLoad(
+		MoveTemp(ConfigsToLoad), EGameFeatureStreamingPriority::GameplayCritical,
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleEntityConfigsLoaded, MakeWeakObjectPtr(World), ChangeContext), GetName());
+
+	if (LoadHandle.IsValid())
+	{
+		ActiveData.LoadHandles.Add(LoadHandle);
+	}
+}
+
+bool UGameFeatureAction_AddMassEntities::IsEntryForWorld(const FGameFeatureMassSpawnEntry& Entry, const UWorld& World)
+{
+	if (!Entry.TargetWorld.IsNull())
+	{
+		const UWorld* TargetWorld = Entry.TargetWorld.Get();
+		if (TargetWorld != &World)
+		{
+			// These entities are intended for a specific world (not this one)
+			return false;
+		}
+	}
+
+	return (Entry.Count > 0) && !Entry.EntityTypes.IsEmpty();
+}
+
+void UGameFeatureAction_AddMassEntities::HandleEntityConfigsLoaded(TWeakObjectPtr<UWorld> WeakWorld, FGameFeatureStateChangeContext ChangeContext)
+{
+	if (UWorld* World = WeakWorld.Get())
+	{
+		GenerateSpawnData(*World, ChangeContext);
+	}
+}
+
+void UGameFeatureAction_AddMassEntities::GenerateSpawnData(UWorld& World, const FGameFeatureStateChangeContext& ChangeContext)
+{
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	if (ActiveData == nullptr)
+	{
+		return;
+	}
+
+#if WITH_EDITOR
+	// Allow resolving of TargetWorld in proper context
+	FTemporaryPlayInEditorIDOverride IDHelper(World.GetPackage()->GetPIEInstanceID());
+#endif
+
+	for (int32 EntryIndex = 0; EntryIndex < SpawnList.Num(); ++EntryIndex)
+	{
+		const FGameFeatureMassSpawnEntry& Entry = SpawnList[EntryIndex];
+
+		if (!IsEntryForWorld(Entry, World))
+		{
+			continue;
+		}
+
+		for (const FMassSpawnedEntityType& EntityType : Entry.EntityTypes)
+		{
+			ensureAlwaysMsgf(EntityType.EntityConfig.IsNull() || EntityType.EntityConfig.Get(), TEXT("Failed to load asset [%s]"), *EntityType.EntityConfig.ToString());
+		}
+
+		float TotalProportion = 0.f;
+		for (const FMassSpawnDataGenerator& Generator : Entry.SpawnDataGenerators)
+		{
+			if (Generator.GeneratorInstance)
+			{
+				TotalProportion += Generator.Proportion;
+			}
+		}
+
+		if (TotalProportion <= 0.f)
+		{
+			continue;
+		}
+
+		// Counts are handed out from the running total of proportions, so rounding never adds up to more or less than Entry.Count
+		float AssignedProportion = 0.f;
+		int32 AssignedCount = 0;
+		for (const FMassSpawnDataGenerator& Generator : Entry.SpawnDataGenerators)
+		{
+			if (!Generator.GeneratorInstance)
+			{
+				continue;
+			}
+
+			AssignedProportion += Generator.Proportion;
+			const int32 TotalCount = FMath::Min(FMath::RoundToInt(AssignedProportion / TotalProportion * Entry.Count), Entry.Count);
+			const int32 SpawnCount = TotalCount - AssignedCount;
+			AssignedCount = TotalCount;
+
+			if (SpawnCount <= 0)
+			{
+				continue;
+			}
+
+			FFinishedGeneratingSpawnDataSignature FinishedDelegate = FFinishedGeneratingSpawnDataSignature::CreateUObject(
+				this, &ThisClass::HandleSpawnDataGenerated, ChangeContext, MakeWeakObjectPtr(&World), EntryIndex, ActiveData->bAlive);
+
+			Generator.GeneratorInstance->Generate(World, Entry.EntityTypes, SpawnCount, FinishedDelegate);
+		}
+	}
+}
+
+void UGameFeatureAction_AddMassEntities::HandleSpawnDataGenerated(TConstArrayView<FMassEntitySpawnDataGeneratorResult> Results, FGameFeatureStateChangeContext ChangeContext, TWeakObjectPtr<UWorld> WeakWorld, int32 EntryIndex, TSharedRef<bool> bContextAlive)
+{
+	LLM_SCOPE_GAMEFEATURESEXTENSION(this);
+	TRACE_GAMEFEATURESEXTENSION_SCOPE_BOOKMARK(TEXT("GameFeatureAction SpawnDataGenerated"), TEXT("%s %s"), *GetPackage()->GetName(), *GetClass()->GetName());
+
+	UWorld* World = WeakWorld.Get();
+	if (!*bContextAlive || (World == nullptr) || !SpawnList.IsValidIndex(EntryIndex))
+	{
+		return;
+	}
+
+	FPerContextData* ActiveData = FindContextState<FPerContextData>(ChangeContext);
+	UMassSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(World);
+	if ((ActiveData == nullptr) || (SpawnerSubsystem == nullptr))
+	{
+		return;
+	}
+
+	FSpawnedEntities* WorldEntities = ActiveData->SpawnedEntities.FindByPredicate([World](const FSpawnedEntities& Spawned)
+		{
+			return Spawned.World == World;
+		});
+
+	if (WorldEntities == nullptr)
+	{
+		WorldEntities = &ActiveData->SpawnedEntities.AddDefaulted_GetRef();
+		WorldEntities->World = World;
+	}
+
+	const FGameFeatureMassSpawnEntry& Entry = SpawnList[EntryIndex];
+	for (const FMassEntitySpawnDataGeneratorResult& Result : Results)
+	{
+		if ((Result.NumEntities <= 0) || !Entry.EntityTypes.IsValidIndex(Result.EntityConfigIndex))
+		{
+			continue;
+		}
+
+		const UMassEntityConfigAsset* EntityConfig = Entry.EntityTypes[Result.EntityConfigIndex].EntityConfig.Get();
+		if (EntityConfig == nullptr)
+		{
+			continue;
+		}
+
+		const FMassEntityTemplate& EntityTemplate = EntityConfig->GetOrCreateEntityTemplate(*World);
+		if (!EntityTemplate.IsValid())
+		{
+			continue;
+		}
+
+		// Creates all entities of the template in one batch, filling whole archetype chunks at once
+		TArray<FMassEntityHandle> Entities;
+		SpawnerSubsystem->SpawnEntities(EntityTemplate.GetTemplateID(), Result.NumEntities, Result.SpawnData, Result.SpawnDataProcessor, Entities);
+		WorldEntities->Entities.Append(MoveTemp(Entities));
+	}
+}
+
+void UGameFeatureAction_AddMassEntities::CancelLoads(FPerContextData& ActiveData)
+{
+	for (const TSharedPtr<FStreamableHandle>& LoadHandle : ActiveData.LoadHandles)
+	{
+		if (LoadHandle.IsValid())
+		{
+			LoadHandle->CancelHandle();
+		}
+	}
+	ActiveData.LoadHandles.Empty();
+}
+
+void UGameFeatureAction_AddMassEntities::ResetContextState(FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	*ActiveData.bAlive = false;
+	CancelLoads(ActiveData);
+
+	for (const FSpawnedEntities& Spawned : ActiveData.SpawnedEntities)
+	{
+		if (UWorld* World = Spawned.World.Get())
+		{
+			if (UMassSpawnerSubsystem* SpawnerSubsystem = UWorld::GetSubsystem<UMassSpawnerSubsystem>(World))
+			{
+				SpawnerSubsystem->DestroyEntities(Spawned.Entities);
+			}
+		}
+	}
+
+	ActiveData.SpawnedEntities.Empty();
+}
+
+bool UGameFeatureAction_AddMassEntities::SupportsIncrementalTeardown() const
+{
+	return true;
+}
+
+bool UGameFeatureAction_AddMassEntities::ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState)
+{
+	// Destroyed in batches, a single batch still removes whole archetype chunks at once
+	static constexpr int32 EntitiesPerStep = 512;
+
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	*ActiveData.bAlive = false;
+	CancelLoads(ActiveData);
+
+	if (!ActiveData.SpawnedEntities.IsEmpty())
+	{
+		FSpawnedEntities& Spawned = ActiveData.SpawnedEntities.Last();
+		const int32 NumToDestroy = FMath::Min(Spawned.Entities.Num(), EntitiesPerStep);
+
+		UWorld* World = Spawned.World.Get();
+		if (UMassSpawnerSubsystem* SpawnerSubsystem = World ? UWorld::GetSubsystem<UMassSpawnerSubsystem>(World) : nullptr)
+		{
+			SpawnerSubsystem->DestroyEntities(MakeArrayView(Spawned.Entities).Right(NumToDestroy));
+		}
+
+		Spawned.Entities.RemoveAt(Spawned.Entities.Num() - NumToDestroy, NumToDestroy, EAllowShrinking::No);
+		if (Spawned.Entities.IsEmpty() || (World == nullptr))
+		{
+			ActiveData.SpawnedEntities.Pop(EAllowShrinking::No);
+		}
+	}
+
+	return ActiveData.SpawnedEntities.IsEmpty();
+}
+
+void UGameFeatureAction_AddMassEntities::OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState)
+{
+	FPerContextData& ActiveData = static_cast<FPerContextData&>(ContextState);
+
+	// The entity manager is torn down with its world, only forget about the handles
+	ActiveData.SpawnedEntities.RemoveAllSwap([World](const FSpawnedEntities& Spawned)
+		{
+			return !Spawned.World.IsValid() || Spawned.World == World;
+		});
+}
+
+#undef LOCTEXT_NAMESPACE
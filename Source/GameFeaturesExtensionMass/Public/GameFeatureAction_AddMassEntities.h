@@ -0,0 +1,130 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "GameFeatureAction_WorldActionBase.h"
+#include "MassEntityTypes.h"
+#include "MassSpawnerTypes.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/SoftObjectPtr.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "GameFeatureAction_AddMassEntities.generated.h"
+
+class FText;
+class UObject;
+class UWorld;
+struct FAssetBundleData;
+struct FMassEntitySpawnDataGeneratorResult;
+struct FStreamableHandle;
+struct FWorldContext;
+
+/** Record for the game feature data. Specifies which Mass entities to spawn for target worlds. */
+USTRUCT()
+struct FGameFeatureMassSpawnEntry
+{
+	GENERATED_BODY()
+
+	// The world to spawn the entities in (can be left blank, in which case we'll spawn them in all worlds)
+	UPROPERTY(EditAnywhere, Category = "Feature Data")
+	TSoftObjectPtr<UWorld> TargetWorld;
+
+	// Total number of entities to spawn, split between the entity types by their proportion
+	UPROPERTY(EditAnywhere, Category = "Feature Data", meta = (ClampMin = "0"))
+	int32 Count = 0;
+
+	// The entity configs to spawn
+	UPROPERTY(EditAnywhere, Category = "Feature Data")
+	TArray<FMassSpawnedEntityType> EntityTypes;
+
+	// Generators providing the spawn locations, split between the generators by their proportion
+	UPROPERTY(EditAnywhere, Category = "Feature Data")
+	TArray<FMassSpawnDataGenerator> SpawnDataGenerators;
+};
+
+/**
+ * GameFeature action which spawns MassEntity agents into particular levels at runtime.
+ * Entities are created in batches per entity template instead of one actor at a time, making it suitable for large populations.
+ */
+UCLASS(MinimalAPI, meta = (DisplayName = "Add Mass Entities"))
+class UGameFeatureAction_AddMassEntities final : public UGameFeatureAction_WorldActionBase
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UGameFeatureAction interface
+#if WITH_EDITORONLY_DATA
+	virtual void AddAdditionalAssetBundleData(FAssetBundleData& AssetBundleData) override;
+#endif
+	//~ End UGameFeatureAction interface
+
+	//~ Begin UObject interface
+#if WITH_EDITOR
+	virtual EDataValidationResult IsDataValid(class FDataValidationContext& Context) const override;
+#endif
+	//~ End UObject interface
+
+	UPROPERTY(EditAnywhere, Category = "Mass", meta = (TitleProperty = "TargetWorld"))
+	TArray<FGameFeatureMassSpawnEntry> SpawnList;
+
+private:
+	//~ Begin UGameFeatureAction_WorldActionBase interface
+	virtual void GatherPrewarmAssets(TArray<FSoftObjectPath>& OutAssets) const override;
+	virtual void OnAddToWorld(const FWorldContext& WorldContext, const FGameFeatureStateChangeContext& ChangeContext) override;
+	virtual void ResetContextState(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual bool SupportsIncrementalTeardown() const override;
+	virtual bool ResetContextStateStep(FGameFeatureWorldActionContextState& ContextState) override;
+	virtual void OnWorldCleanup(UWorld* World, FGameFeatureWorldActionContextState& ContextState) override;
+	//~ End UGameFeatureAction_WorldActionBase interface
+
+	/** Whether the entities of Entry should be spawned in World, TargetWorld has to be resolvable in the world's PIE context */
+	static bool IsEntryForWorld(const FGameFeatureMassSpawnEntry& Entry, const UWorld& World);
+
+	void HandleEntityConfigsLoaded(TWeakObjectPtr<UWorld> WeakWorld, FGameFeatureStateChangeContext ChangeContext);
+
+	/** Runs the spawn data generators of every entry for World, once their entity configs are loaded */
+	void GenerateSpawnData(UWorld& World, const FGameFeatureStateChangeContext& ChangeContext);
+
+	/** Spawns the entities for the generated results, unless the context was deactivated while the generator was running */
+	void HandleSpawnDataGenerated(TConstArrayView<FMassEntitySpawnDataGeneratorResult> Results, FGameFeatureStateChangeContext ChangeContext, TWeakObjectPtr<UWorld> WeakWorld, int32 EntryIndex, TSharedRef<bool> bContextAlive);
+
+	struct FSpawnedEntities
+	{
+		TWeakObjectPtr<UWorld> World;
+		TArray<FMassEntityHandle> Entities;
+	};
+
+	struct FPerContextData : public FGameFeatureWorldActionContextState
+	{
+		TArray<TSharedPtr<FStreamableHandle>> LoadHandles;
+
+		/** Entities spawned per world */
+		TArray<FSpawnedEntities> SpawnedEntities;
+
+		/** Cleared on reset, generators may finish asynchronously after the context is gone */
+		TSharedRef<bool> bAlive = MakeShared<bool>(true);
+
+		virtual void Describe(FStringBuilderBase& Out) const override
+		{
+			int32 NumEntities = 0;
+			for (const FSpawnedEntities& Spawned : SpawnedEntities)
+			{
+				NumEntities += Spawned.Entities.Num();
+			}
+			Out.Appendf(TEXT("Loads=%d Worlds=%d Entities=%d"), LoadHandles.Num(), SpawnedEntities.Num(), NumEntities);
+		}
+
+		virtual SIZE_T GetAllocatedSize() const override
+		{
+			SIZE_T Size = LoadHandles.GetAllocatedSize() + SpawnedEntities.GetAllocatedSize();
+			for (const FSpawnedEntities& Spawned : SpawnedEntities)
+			{
+				Size += Spawned.Entities.GetAllocatedSize();
+			}
+			return Size;
+		}
+	};
+
+	static void CancelLoads(FPerContextData& ActiveData);
+};
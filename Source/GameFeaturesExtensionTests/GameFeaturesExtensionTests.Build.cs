@@ -0,0 +1,20 @@
+﻿// Copyright © 2025 MajorT. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class GameFeaturesExtensionTests : ModuleRules
+{
+	public GameFeaturesExtensionTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PrivateDependencyModuleNames.AddRange(new[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"CommonUI",
+			"EnhancedInput",
+			"GameFeatures",
+			"GameFeaturesExtension",
+		});
+	}
+}
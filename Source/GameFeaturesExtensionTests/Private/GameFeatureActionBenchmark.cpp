@@ -0,0 +1,571 @@
+// Copyright © 2025 MajorT. All Rights Reserved.
+
+
+#include "CommonActivatableWidget.h"
+#include "GameFeatureActionSet.h"
+#include "GameFeatureDevelopmentScopes.h"
+#include "GameFeatureAction_AddInputMappingContext.h"
+#include "GameFeatureAction_AddLevelInstances.h"
+#include "GameFeatureAction_AddSpawnedActors.h"
+#include "GameFeatureAction_AddWidget.h"
+#include "GameFeatureAction_AddWorldSystem.h"
+#include "GameFeatureAction_SplitscreenConfig.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Engine/World.h"
+#include "InputMappingContext.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/Package.h"
+#include "UObject/PropertyPortFlags.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/UObjectHash.h"
+
+#if !UE_BUILD_SHIPPING
+
+/**
+ * Development harnesses measuring the activate/deactivate cost of every built-in world action,
+ * and the scaling behavior of many synthetic features cycled across several world contexts.
+ * Synthetic actions are created in the transient package and cycled against transient game instances created for the run,
+ * so results don't depend on, and don't disturb, the worlds that happen to be loaded.
+ * Results are compared against the budgets below. The console commands report regressions as errors,
+ * the automation tests of the same name fail on them, e.g. when run on a -nullrhi editor with -ExecCmds="Automation RunTests GameFeaturesExtension".
+ * Used physical memory is only reported, it moves with everything else the process does and is too noisy to fail on.
+ * This module is a developer tool, none of it ships.
+ */
+namespace UE::GameFeaturesExtension::Benchmark
+{
+	static float MaxActivationMs = 2.f;
+	static FAutoConsoleVariableRef CVarMaxActivationMs(
+		TEXT("GameFeaturesExtension.Benchmark.MaxActivationMs"),
+		MaxActivationMs,
+		TEXT("Average activation time (ms) per action above which the benchmark reports a regression."));
+
+	static float MaxDeactivationMs = 2.f;
+	static FAutoConsoleVariableRef CVarMaxDeactivationMs(
+		TEXT("GameFeaturesExtension.Benchmark.MaxDeactivationMs"),
+		MaxDeactivationMs,
+		TEXT("Average deactivation time (ms) per action above which the benchmark reports a regression."));
+
+	static int32 MaxLeakedObjects = 0;
+	static FAutoConsoleVariableRef CVarMaxLeakedObjects(
+		TEXT("GameFeaturesExtension.Benchmark.MaxLeakedObjects"),
+		MaxLeakedObjects,
+		TEXT("Number of UObjects that may survive a full cycle and garbage collection before the benchmark reports a regression."));
+
+	struct FActionResult
+	{
+		FString ActionName;
+		double ActivationMs = 0.0;
+		double DeactivationMs = 0.0;
+		int32 PeakObjectDelta = 0;
+		int32 LeakedObjects = 0;
+		int64 MemoryDeltaKB = 0;
+		int32 DeferredDeactivations = 0;
+	};
+
+	static int32 GetNumLiveObjects()
+	{
+		return GUObjectArray.GetObjectArrayNumMinusAvailable();
+	}
+
+	static int64 GetUsedPhysicalKB()
+	{
+		return static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical / 1024);
+	}
+
+	static TArray<TSubclassOf<UGameFeatureAction>> GetBuiltInActionClasses()
+	{
+		return
+		{
+			UGameFeatureAction_AddInputMappingContext::StaticClass(),
+			UGameFeatureAction_AddWidget::StaticClass(),
+			UGameFeatureAction_AddSpawnedActors::StaticClass(),
+			UGameFeatureAction_AddLevelInstances::StaticClass(),
+			UGameFeatureAction_AddWorldSystem::StaticClass(),
+			UGameFeatureAction_SplitscreenConfig::StaticClass(),
+		};
+	}
+
+	/** Level streamed in by synthetic level instance entries, it ships with the engine so no project content is needed */
+	static const TCHAR* SyntheticLevelPath = TEXT("/Engine/Maps/Entry.Entry");
+
+	/** Returns the first native or loaded world system class that can be instantiated, if any */
+	static UClass* FindConcreteWorldSystemClass()
+	{
+		TArray<UClass*> SystemClasses;
+		GetDerivedClasses(UGameFeatureWorldSystem::StaticClass(), SystemClasses);
+
+		UClass* const* Found = SystemClasses.FindByPredicate([](const UClass* Class)
+			{
+				return !Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists);
+			});
+		return Found ? *Found : nullptr;
+	}
+
+	/** Sets a property of Action from its text form, for configuration the action doesn't expose to other modules */
+	static void ImportSyntheticProperty(UGameFeatureAction* Action, FName PropertyName, const FString& Text)
+	{
+		const FProperty* Property = FindFProperty<FProperty>(Action->GetClass(), PropertyName);
+		if (ensureMsgf(Property, TEXT("%s has no property %s"), *GetNameSafe(Action->GetClass()), *PropertyName.ToString()))
+		{
+			Property->ImportText_InContainer(*Text, Action, Action, PPF_None);
+		}
+	}
+
+	/** Fills the configuration of an action with synthetic entries that work without any project content. */
+	static void ConfigureSyntheticAction(UGameFeatureAction* Action, int32 NumEntries)
+	{
+		if (UGameFeatureAction_AddSpawnedActors* SpawnedActors = Cast<UGameFeatureAction_AddSpawnedActors>(Action))
+		{
+			FSpawningWorldActorsEntry& WorldEntry = SpawnedActors->ActorsList.AddDefaulted_GetRef();
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				FSpawningActorEntry& ActorEntry = WorldEntry.Actors.AddDefaulted_GetRef();
+				ActorEntry.ActorType = AActor::StaticClass();
+				ActorEntry.SpawnTransform.SetLocation(FVector(100.f * Index, 0.f, 0.f));
+			}
+		}
+		else if (Action->IsA<UGameFeatureAction_AddInputMappingContext>())
+		{
+			TArray<FString> Entries;
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				// Outered to the action, so the mapping contexts go away with it
+				const UInputMappingContext* MappingContext = NewObject<UInputMappingContext>(Action, NAME_None, RF_Transient);
+				Entries.Add(FString::Printf(TEXT("(InputMapping=\"%s\",Priority=%d)"), *MappingContext->GetPathName(), Index));
+			}
+			ImportSyntheticProperty(Action, TEXT("InputMappings"), FString::Printf(TEXT("(%s)"), *FString::Join(Entries, TEXT(","))));
+		}
+		else if (Action->IsA<UGameFeatureAction_AddWidget>())
+		{
+			const FString WidgetClassPath = UCommonActivatableWidget::StaticClass()->GetPathName();
+
+			TArray<FString> Layouts;
+			TArray<FString> Widgets;
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				Layouts.Add(FString::Printf(TEXT("(LayoutClass=\"%s\")"), *WidgetClassPath));
+				Widgets.Add(FString::Printf(TEXT("(WidgetClass=\"%s\")"), *WidgetClassPath));
+			}
+			ImportSyntheticProperty(Action, TEXT("Layouts"), FString::Printf(TEXT("(%s)"), *FString::Join(Layouts, TEXT(","))));
+			ImportSyntheticProperty(Action, TEXT("Widgets"), FString::Printf(TEXT("(%s)"), *FString::Join(Widgets, TEXT(","))));
+		}
+		else if (UGameFeatureAction_AddLevelInstances* LevelInstances = Cast<UGameFeatureAction_AddLevelInstances>(Action))
+		{
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				FGameFeatureLevelInstanceEntry& Entry = LevelInstances->LevelInstanceList.AddDefaulted_GetRef();
+				Entry.Level = TSoftObjectPtr<UWorld>(FSoftObjectPath(SyntheticLevelPath));
+				Entry.Location = FVector(10000.f * Index, 0.f, 0.f);
+			}
+		}
+		else if (UGameFeatureAction_AddWorldSystem* WorldSystem = Cast<UGameFeatureAction_AddWorldSystem>(Action))
+		{
+			// World systems are only ever authored in blueprints, there is nothing to request without a concrete class
+			if (UClass* SystemClass = FindConcreteWorldSystemClass())
+			{
+				for (int32 Index = 0; Index < NumEntries; ++Index)
+				{
+					WorldSystem->WorldSystemsList.AddDefaulted_GetRef().SystemType = SystemClass;
+				}
+			}
+		}
+		else if (UGameFeatureAction_SplitscreenConfig* Splitscreen = Cast<UGameFeatureAction_SplitscreenConfig>(Action))
+		{
+			Splitscreen->bDisableSplitscreen = true;
+		}
+	}
+
+	/** Runs NumCycles register/activate/deactivate/unregister cycles for a single action class against the given world context. */
+	static FActionResult RunForActionClass(TSubclassOf<UGameFeatureAction> ActionClass, int32 NumCycles, int32 NumEntries, FName WorldContextHandle)
+	{
+		FActionResult Result;
+		Result.ActionName = GetNameSafe(ActionClass);
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const int32 BaselineObjects = GetNumLiveObjects();
+		const int64 BaselineMemoryKB = GetUsedPhysicalKB();
+
+		for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+		{
+			UGameFeatureAction* Action = NewObject<UGameFeatureAction>(GetTransientPackage(), ActionClass, NAME_None, RF_Transient);
+			ConfigureSyntheticAction(Action, NumEntries);
+
+			Action->OnGameFeatureRegistering();
+
+			FGameFeatureActivatingContext ActivatingContext;
+			ActivatingContext.SetRequiredWorldContextHandle(WorldContextHandle);
+			const double ActivateStart = FPlatformTime::Seconds();
+			Action->OnGameFeatureActivating(ActivatingContext);
+			Result.ActivationMs += (FPlatformTime::Seconds() - ActivateStart) * 1000.0;
+
+			Result.PeakObjectDelta = FMath::Max(Result.PeakObjectDelta, GetNumLiveObjects() - BaselineObjects);
+
+			TSharedRef<int32> NumResumed = MakeShared<int32>(0);
+			FGameFeatureDeactivatingContext DeactivatingContext(TEXTVIEW("GameFeaturesExtensionBenchmark"), [NumResumed](FStringView) { ++(*NumResumed); });
+			DeactivatingContext.SetRequiredWorldContextHandle(WorldContextHandle);
+			const double DeactivateStart = FPlatformTime::Seconds();
+			Action->OnGameFeatureDeactivating(DeactivatingContext);
+			Result.DeactivationMs += (FPlatformTime::Seconds() - DeactivateStart) * 1000.0;
+
+			// Anything still paused would finish outside of the measured time
+			Result.DeferredDeactivations += DeactivatingContext.GetNumPausers() - *NumResumed;
+
+			Action->OnGameFeatureUnregistering();
+			Action->MarkAsGarbage();
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		Result.LeakedObjects = GetNumLiveObjects() - BaselineObjects;
+		Result.MemoryDeltaKB = GetUsedPhysicalKB() - BaselineMemoryKB;
+
+		Result.ActivationMs /= NumCycles;
+		Result.DeactivationMs /= NumCycles;
+
+		return Result;
+	}
+
+	/** Reports a single result, returns false if any of the configured thresholds were exceeded. */
+	static bool ReportResult(const FActionResult& Result, FOutputDevice& Ar)
+	{
+		Ar.Logf(TEXT("%-48s Activate: %8.3f ms  Deactivate: %8.3f ms  PeakObjects: %6d  LeakedObjects: %6d  MemoryDelta: %8lld KB"),
+			*Result.ActionName, Result.ActivationMs, Result.DeactivationMs, Result.PeakObjectDelta, Result.LeakedObjects, Result.MemoryDeltaKB);
+
+		bool bPassed = true;
+		if (Result.ActivationMs > MaxActivationMs)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Benchmark regression: %s activation took %.3f ms (budget %.3f ms)"), *Result.ActionName, Result.ActivationMs, MaxActivationMs);
+			bPassed = false;
+		}
+
+		if (Result.DeactivationMs > MaxDeactivationMs)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Benchmark regression: %s deactivation took %.3f ms (budget %.3f ms)"), *Result.ActionName, Result.DeactivationMs, MaxDeactivationMs);
+			bPassed = false;
+		}
+
+		if (Result.LeakedObjects > MaxLeakedObjects)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Benchmark regression: %s left %d objects alive after a full cycle (budget %d)"), *Result.ActionName, Result.LeakedObjects, MaxLeakedObjects);
+			bPassed = false;
+		}
+
+		if (Result.DeferredDeactivations > 0)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Benchmark regression: %s left %d deactivations paused, their teardown wasn't measured"), *Result.ActionName, Result.DeferredDeactivations);
+			bPassed = false;
+		}
+
+		return bPassed;
+	}
+
+	/** Runs the benchmark in a transient game instance, returns false if any action exceeded its budget. */
+	static bool RunBenchmark(int32 NumCycles, int32 NumEntries, FOutputDevice& Ar)
+	{
+		const TArray<TSubclassOf<UGameFeatureAction>> ActionClasses = GetBuiltInActionClasses();
+		Ar.Logf(TEXT("GameFeaturesExtension benchmark: %d cycles, %d synthetic entries per action"), NumCycles, NumEntries);
+
+		const FScopedSynchronousGameFeatureTeardown SynchronousTeardown;
+		if (!SynchronousTeardown.IsActive())
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GameFeaturesExtension benchmark aborted: teardown can't be made synchronous"));
+			return false;
+		}
+
+		const FGameFeatureTransientGameInstance GameInstance(TEXT("GameFeaturesExtensionBenchmark"));
+
+		const int32 NumActions = ActionClasses.Num();
+		int32 NumFailed = 0;
+		for (const TSubclassOf<UGameFeatureAction>& ActionClass : ActionClasses)
+		{
+			if (!ReportResult(RunForActionClass(ActionClass, NumCycles, NumEntries, GameInstance.GetContextHandle()), Ar))
+			{
+				++NumFailed;
+			}
+		}
+
+		Ar.Logf(NumFailed > 0 ? ELogVerbosity::Error : ELogVerbosity::Display,
+			TEXT("GameFeaturesExtension benchmark finished: %d of %d actions within budget"), NumActions - NumFailed, NumActions);
+		return NumFailed == 0;
+	}
+
+	static void RunBenchmarkCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumCycles = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10);
+		const int32 NumEntries = FMath::Max(0, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 8);
+		RunBenchmark(NumCycles, NumEntries, Ar);
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice BenchmarkCommand(
+		TEXT("GameFeaturesExtension.Benchmark"),
+		TEXT("Cycles synthetic instances of every built-in world action against a transient game instance and reports timings, object and memory deltas. Fails on timings and objects only. Usage: GameFeaturesExtension.Benchmark [NumCycles=10] [NumEntries=8]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunBenchmarkCommand));
+
+	/** Sum of the per-context bookkeeping entries held by all world actions of the given synthetic features. */
+	static int32 CountContextEntries(TConstArrayView<UGameFeatureActionSet*> Features)
+	{
+		int32 NumEntries = 0;
+		for (const UGameFeatureActionSet* Feature : Features)
+		{
+			for (const UGameFeatureAction* Action : Feature->Actions)
+			{
+				if (const UGameFeatureAction_WorldActionBase* WorldAction = Cast<UGameFeatureAction_WorldActionBase>(Action))
+				{
+					NumEntries += WorldAction->GetNumContextEntries();
+				}
+			}
+		}
+		return NumEntries;
+	}
+
+	/** Sum of the runtime bookkeeping memory held by all world actions of the given synthetic features. */
+	static SIZE_T CountRuntimeAllocatedSize(TConstArrayView<UGameFeatureActionSet*> Features)
+	{
+		SIZE_T Size = 0;
+		for (const UGameFeatureActionSet* Feature : Features)
+		{
+			for (const UGameFeatureAction* Action : Feature->Actions)
+			{
+				if (const UGameFeatureAction_WorldActionBase* WorldAction = Cast<UGameFeatureAction_WorldActionBase>(Action))
+				{
+					Size += WorldAction->GetRuntimeAllocatedSize();
+				}
+			}
+		}
+		return Size;
+	}
+
+	static int32 CountActiveActions()
+	{
+		int32 NumActions = 0;
+		UGameFeatureAction_WorldActionBase::ForEachActiveAction([&NumActions](const UGameFeatureAction_WorldActionBase&) { ++NumActions; });
+		return NumActions;
+	}
+
+	/**
+	 * Generates NumFeatures synthetic features with NumActionsPerFeature actions each and cycles them NumCycles times
+	 * across the given world contexts (each one owned by a separate game instance). Fails unless context entries,
+	 * active actions, deferred teardowns and UObjects all return to their baseline afterwards.
+	 */
+	static bool RunSoakIteration(int32 NumFeatures, int32 NumActionsPerFeature, int32 NumCycles, TConstArrayView<FName> WorldContextHandles, FOutputDevice& Ar)
+	{
+		const TArray<TSubclassOf<UGameFeatureAction>> ActionClasses = GetBuiltInActionClasses();
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const int32 BaselineObjects = GetNumLiveObjects();
+		const int32 BaselineActiveActions = CountActiveActions();
+		const int32 BaselineDeferredContexts = UGameFeatureAction_WorldActionBase::GetNumDeferredContexts();
+		const int64 BaselineMemoryKB = GetUsedPhysicalKB();
+
+		TArray<UGameFeatureActionSet*> Features;
+		Features.Reserve(NumFeatures);
+		for (int32 FeatureIndex = 0; FeatureIndex < NumFeatures; ++FeatureIndex)
+		{
+			UGameFeatureActionSet* Feature = NewObject<UGameFeatureActionSet>(GetTransientPackage(), NAME_None, RF_Transient);
+			for (int32 ActionIndex = 0; ActionIndex < NumActionsPerFeature; ++ActionIndex)
+			{
+				const TSubclassOf<UGameFeatureAction>& ActionClass = ActionClasses[(FeatureIndex * NumActionsPerFeature + ActionIndex) % ActionClasses.Num()];
+				UGameFeatureAction* Action = NewObject<UGameFeatureAction>(Feature, ActionClass, NAME_None, RF_Transient);
+				ConfigureSyntheticAction(Action, 1);
+				Feature->Actions.Add(Action);
+			}
+			Features.Add(Feature);
+		}
+
+		for (UGameFeatureActionSet* Feature : Features)
+		{
+			for (UGameFeatureAction* Action : Feature->Actions)
+			{
+				Action->OnGameFeatureRegistering();
+			}
+		}
+
+		int32 PeakObjectDelta = 0;
+		int32 PeakContextEntries = 0;
+		SIZE_T PeakRuntimeSize = 0;
+		double CycleSeconds = 0.0;
+
+		for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+		{
+			const double CycleStart = FPlatformTime::Seconds();
+
+			for (const FName& Handle : WorldContextHandles)
+			{
+				FGameFeatureActivatingContext ActivatingContext;
+				ActivatingContext.SetRequiredWorldContextHandle(Handle);
+
+				for (UGameFeatureActionSet* Feature : Features)
+				{
+					for (UGameFeatureAction* Action : Feature->Actions)
+					{
+						Action->OnGameFeatureActivating(ActivatingContext);
+					}
+				}
+			}
+
+			PeakObjectDelta = FMath::Max(PeakObjectDelta, GetNumLiveObjects() - BaselineObjects);
+			PeakContextEntries = FMath::Max(PeakContextEntries, CountContextEntries(Features));
+			PeakRuntimeSize = FMath::Max(PeakRuntimeSize, CountRuntimeAllocatedSize(Features));
+
+			for (const FName& Handle : WorldContextHandles)
+			{
+				FGameFeatureDeactivatingContext DeactivatingContext(TEXTVIEW("GameFeaturesExtensionSoak"), [](FStringView) {});
+				DeactivatingContext.SetRequiredWorldContextHandle(Handle);
+
+				for (UGameFeatureActionSet* Feature : Features)
+				{
+					for (UGameFeatureAction* Action : Feature->Actions)
+					{
+						Action->OnGameFeatureDeactivating(DeactivatingContext);
+					}
+				}
+			}
+
+			CycleSeconds += FPlatformTime::Seconds() - CycleStart;
+		}
+
+		const int32 RemainingContextEntries = CountContextEntries(Features);
+		const int32 RemainingActiveActions = CountActiveActions() - BaselineActiveActions;
+		const int32 RemainingDeferredContexts = UGameFeatureAction_WorldActionBase::GetNumDeferredContexts() - BaselineDeferredContexts;
+
+		for (UGameFeatureActionSet* Feature : Features)
+		{
+			for (UGameFeatureAction* Action : Feature->Actions)
+			{
+				Action->OnGameFeatureUnregistering();
+				Action->MarkAsGarbage();
+			}
+			Feature->MarkAsGarbage();
+		}
+		Features.Empty();
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		const int32 LeakedObjects = GetNumLiveObjects() - BaselineObjects;
+		const int64 MemoryDeltaKB = GetUsedPhysicalKB() - BaselineMemoryKB;
+
+		Ar.Logf(TEXT("Features: %5d  Actions: %6d  Cycle: %9.3f ms  PeakObjects: %7d  PeakContextEntries: %7d  PeakBookkeeping: %8llu KB  RemainingContextEntries: %6d  RemainingActive: %6d  RemainingDeferred: %6d  LeakedObjects: %6d  MemoryDelta: %8lld KB"),
+			NumFeatures, NumFeatures * NumActionsPerFeature, (CycleSeconds * 1000.0) / NumCycles, PeakObjectDelta, PeakContextEntries, static_cast<uint64>(PeakRuntimeSize / 1024),
+			RemainingContextEntries, RemainingActiveActions, RemainingDeferredContexts, LeakedObjects, MemoryDeltaKB);
+
+		bool bPassed = true;
+		if (RemainingContextEntries > 0)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Soak regression: %d per-context entries remain after deactivating %d features"), RemainingContextEntries, NumFeatures);
+			bPassed = false;
+		}
+
+		if (RemainingActiveActions != 0)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Soak regression: %d more world actions are registered as active after deactivating %d features"), RemainingActiveActions, NumFeatures);
+			bPassed = false;
+		}
+
+		if (RemainingDeferredContexts != 0)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Soak regression: %d more contexts are queued for teardown or retained after deactivating %d features"), RemainingDeferredContexts, NumFeatures);
+			bPassed = false;
+		}
+
+		if (LeakedObjects > MaxLeakedObjects)
+		{
+			UE_LOG(LogGameFeatures, Error, TEXT("Soak regression: %d objects remain after cycling %d features (budget %d)"), LeakedObjects, NumFeatures, MaxLeakedObjects);
+			bPassed = false;
+		}
+
+		return bPassed;
+	}
+
+	/** Runs the soak across NumGameInstances transient game instances, returns false if any scaling step didn't return to its baseline. */
+	static bool RunSoak(int32 NumCycles, int32 NumActionsPerFeature, TConstArrayView<int32> FeatureCounts, int32 NumGameInstances, FOutputDevice& Ar)
+	{
+		const FScopedSynchronousGameFeatureTeardown SynchronousTeardown;
+		if (!SynchronousTeardown.IsActive())
+		{
+			Ar.Logf(ELogVerbosity::Error, TEXT("GameFeaturesExtension soak aborted: teardown can't be made synchronous"));
+			return false;
+		}
+
+		// Every game instance acts as its own change context, so state is exercised per game instance
+		TArray<TUniquePtr<FGameFeatureTransientGameInstance>> GameInstances;
+		TArray<FName> WorldContextHandles;
+		for (int32 Index = 0; Index < NumGameInstances; ++Index)
+		{
+			const FGameFeatureTransientGameInstance& GameInstance = *GameInstances.Add_GetRef(
+				MakeUnique<FGameFeatureTransientGameInstance>(FString::Printf(TEXT("GameFeaturesExtensionSoak_%d"), Index)));
+			WorldContextHandles.Add(GameInstance.GetContextHandle());
+		}
+
+		Ar.Logf(TEXT("GameFeaturesExtension soak: %d cycles, %d actions per feature, %d game instances"), NumCycles, NumActionsPerFeature, NumGameInstances);
+
+		int32 NumFailed = 0;
+		for (const int32 NumFeatures : FeatureCounts)
+		{
+			if (!RunSoakIteration(NumFeatures, NumActionsPerFeature, NumCycles, WorldContextHandles, Ar))
+			{
+				++NumFailed;
+			}
+		}
+
+		Ar.Logf(NumFailed > 0 ? ELogVerbosity::Error : ELogVerbosity::Display,
+			TEXT("GameFeaturesExtension soak finished: %d of %d scaling steps returned to baseline"), FeatureCounts.Num() - NumFailed, FeatureCounts.Num());
+		return NumFailed == 0;
+	}
+
+	static void RunSoakCommand(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const int32 NumCycles = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 5);
+		const int32 NumActionsPerFeature = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 6);
+		const int32 NumGameInstances = FMath::Max(1, Args.IsValidIndex(3) ? FCString::Atoi(*Args[3]) : 4);
+
+		TArray<int32> FeatureCounts;
+		if (Args.IsValidIndex(2))
+		{
+			TArray<FString> Counts;
+			Args[2].ParseIntoArray(Counts, TEXT(","));
+			for (const FString& Count : Counts)
+			{
+				FeatureCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+			}
+		}
+		else
+		{
+			FeatureCounts = { 10, 100, 1000 };
+		}
+
+		RunSoak(NumCycles, NumActionsPerFeature, FeatureCounts, NumGameInstances, Ar);
+	}
+
+	static FAutoConsoleCommandWithWorldArgsAndOutputDevice SoakCommand(
+		TEXT("GameFeaturesExtension.Soak"),
+		TEXT("Generates synthetic features made of built-in world actions, cycles them across several transient game instances and reports the scaling curve of objects, memory and per-context bookkeeping. Usage: GameFeaturesExtension.Soak [NumCycles=5] [ActionsPerFeature=6] [FeatureCounts=10,100,1000] [NumGameInstances=4]"),
+		FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&RunSoakCommand));
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameFeaturesExtensionBenchmarkTest, "GameFeaturesExtension.Benchmark",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+bool FGameFeaturesExtensionBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const bool bPassed = UE::GameFeaturesExtension::Benchmark::RunBenchmark(10, 8, *GLog);
+	TestTrue(TEXT("Every built-in world action is within its benchmark budget"), bPassed);
+	return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameFeaturesExtensionSoakTest, "GameFeaturesExtension.Soak",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::StressFilter)
+
+bool FGameFeaturesExtensionSoakTest::RunTest(const FString& Parameters)
+{
+	const bool bPassed = UE::GameFeaturesExtension::Benchmark::RunSoak(5, 6, { 10, 100, 1000 }, 4, *GLog);
+	TestTrue(TEXT("Objects, context entries and deferred teardowns return to their baseline at every scale"), bPassed);
+	return bPassed;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+#endif // !UE_BUILD_SHIPPING